@@ -0,0 +1,125 @@
+/**
+ * Login throughput benchmark
+ *
+ * Part 1 compares token generation alone: the previous generator (a
+ * std::random_device and mt19937 per login, 32 hex digits written through
+ * a std::stringstream) against TokenGenerator::next() + to_string(), from
+ * 1 to 64 threads.
+ *
+ * Part 2 times a classroom burst: `burst` concurrent SessionManager::create_session
+ * calls (token + DuckDB connection + table insert) spread over the threads.
+ *
+ * Usage: bench-login-throughput [tokens_per_thread] [burst]
+ */
+
+#include "include/session_manager.hpp"
+#include "include/token_generator.hpp"
+#include "include/config.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sql_practice;
+
+namespace {
+
+/**
+ * @brief Previous create_session token code
+ */
+std::string legacy_token() {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(0, 15);
+
+    std::stringstream ss;
+    ss << "sess_";
+    for (int i = 0; i < 32; ++i) {
+        ss << std::hex << dis(gen);
+    }
+    return ss.str();
+}
+
+std::string batched_token() {
+    return TokenGenerator::next().to_string();
+}
+
+/**
+ * @brief Wall time in seconds for `threads` threads each running fn `ops` times
+ */
+template <typename Fn>
+double run_threads(size_t threads, size_t ops, Fn fn) {
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<size_t> checksum{0};
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            size_t local = 0;
+            for (size_t i = 0; i < ops; ++i) {
+                local += fn().size();
+            }
+            checksum.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+
+    while (ready.load() < threads) {
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) worker.join();
+    auto end = std::chrono::steady_clock::now();
+
+    if (checksum.load() != threads * ops * SessionToken::WIRE_LENGTH) {
+        std::fprintf(stderr, "unexpected token length\n");
+        std::exit(1);
+    }
+    return std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t tokens_per_thread = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    size_t burst = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 500;
+    if (tokens_per_thread == 0) tokens_per_thread = 20000;
+    if (burst == 0) burst = 500;
+
+    const size_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+
+    std::printf("Token generation, %zu tokens/thread (tokens/s)\n", tokens_per_thread);
+    std::printf("%-8s %16s %16s %10s\n", "threads", "random_device", "batched", "speedup");
+    for (size_t threads : thread_counts) {
+        double legacy = run_threads(threads, tokens_per_thread, legacy_token);
+        double batched = run_threads(threads, tokens_per_thread, batched_token);
+        double total = static_cast<double>(threads * tokens_per_thread);
+        std::printf("%-8zu %16.0f %16.0f %9.1fx\n", threads, total / legacy, total / batched, legacy / batched);
+    }
+
+    // Size the pool like production for `burst` students
+    Config::max_concurrent_sessions = static_cast<int>(burst);
+
+    std::printf("\nLogin burst of %zu create_session calls\n", burst);
+    std::printf("%-8s %14s %14s\n", "threads", "total ms", "logins/s");
+    for (size_t threads : thread_counts) {
+        if (threads > burst) break;
+        SessionManager manager(3600);
+        size_t per_thread = burst / threads;
+        double seconds = run_threads(threads, per_thread, [&]() {
+            return manager.create_session("student");
+        });
+        double logins = static_cast<double>(per_thread * threads);
+        std::printf("%-8zu %14.1f %14.0f\n", threads, seconds * 1000.0, logins / seconds);
+    }
+
+    return 0;
+}
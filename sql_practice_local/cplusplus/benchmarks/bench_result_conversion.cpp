@@ -0,0 +1,128 @@
+/**
+ * Result conversion microbenchmark
+ *
+ * Compares the previous fetch loop (chunk->GetValue() per cell, boxed into a
+ * duckdb::Value and converted with Value::ToString for text columns) with
+ * DuckDBConnection::execute, which reads each column's UnifiedVectorFormat
+ * once per chunk.
+ *
+ * Usage: bench-result-conversion [rows] [repetitions]
+ */
+
+#include "include/sql_executor.hpp"
+#include <duckdb.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace sql_practice;
+
+namespace {
+
+/**
+ * @brief Previous conversion: one duckdb::Value per cell
+ */
+size_t legacy_fetch(DuckDBConnection& conn, const std::string& sql) {
+    auto* raw = static_cast<duckdb::Connection*>(conn.get_connection());
+    auto query_result = raw->SendQuery(sql);
+    if (query_result->HasError()) {
+        std::fprintf(stderr, "query failed: %s\n", query_result->GetError().c_str());
+        std::exit(1);
+    }
+
+    size_t columns = query_result->ColumnCount();
+    std::vector<ResultColumn> data;
+    for (size_t i = 0; i < columns; ++i) {
+        auto id = query_result->types[i].id();
+        data.emplace_back(id == duckdb::LogicalTypeId::INTEGER || id == duckdb::LogicalTypeId::BIGINT
+                              ? ColumnKind::INTEGER
+                              : id == duckdb::LogicalTypeId::DOUBLE ? ColumnKind::DOUBLE : ColumnKind::TEXT);
+    }
+
+    size_t rows = 0;
+    while (auto chunk = query_result->Fetch()) {
+        if (chunk->size() == 0) break;
+        for (size_t row = 0; row < chunk->size(); ++row) {
+            for (size_t col = 0; col < columns; ++col) {
+                auto value = chunk->GetValue(col, row);
+                auto& column = data[col];
+                if (value.IsNull()) column.append_null();
+                else if (column.kind == ColumnKind::INTEGER) column.append_int(value.GetValue<int64_t>());
+                else if (column.kind == ColumnKind::DOUBLE) column.append_double(value.GetValue<double>());
+                else column.append_text(value.ToString());
+            }
+            rows++;
+        }
+    }
+    return rows;
+}
+
+/**
+ * @brief Median wall time in milliseconds of fetch()
+ */
+template <typename FetchFn>
+double median_ms(int repetitions, size_t expected_rows, FetchFn fetch) {
+    std::vector<double> samples;
+    for (int rep = 0; rep < repetitions; ++rep) {
+        auto start = std::chrono::steady_clock::now();
+        size_t rows = fetch();
+        auto end = std::chrono::steady_clock::now();
+
+        if (rows != expected_rows) {
+            std::fprintf(stderr, "expected %zu rows, got %zu\n", expected_rows, rows);
+            std::exit(1);
+        }
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long rows = argc > 1 ? std::atol(argv[1]) : 100000;
+    int repetitions = argc > 2 ? std::atoi(argv[2]) : 10;
+    if (rows <= 0) rows = 100000;
+    if (repetitions <= 0) repetitions = 10;
+
+    DuckDBConnection conn(":memory:");
+    const std::string n = std::to_string(rows);
+
+    struct Shape {
+        const char* name;
+        std::string sql;
+    };
+    const Shape shapes[] = {
+        {"integers", "SELECT i AS id, i * 7 AS salary, i % 10 AS dept FROM range(" + n + ") t(i)"},
+        {"doubles", "SELECT i / 3.0::DOUBLE AS a, sqrt(i::DOUBLE) AS b FROM range(" + n + ") t(i)"},
+        {"varchar", "SELECT 'employee_' || i AS name, md5(i::VARCHAR) AS hash FROM range(" + n + ") t(i)"},
+        {"mixed", "SELECT i AS id, 'name_' || i AS name, i * 1.5::DOUBLE AS salary, "
+                  "DATE '2020-01-01' + (i % 1000)::INTEGER AS hired, "
+                  "CASE WHEN i % 5 = 0 THEN NULL ELSE i END AS manager_id FROM range(" + n + ") t(i)"},
+    };
+
+    std::printf("Result conversion, %ld rows (median of %d runs)\n", rows, repetitions);
+    std::printf("%-10s %16s %16s %10s\n", "shape", "GetValue ms", "vectorized ms", "speedup");
+
+    for (const auto& shape : shapes) {
+        double legacy = median_ms(repetitions, static_cast<size_t>(rows), [&]() {
+            return legacy_fetch(conn, shape.sql);
+        });
+        double vectorized = median_ms(repetitions, static_cast<size_t>(rows), [&]() {
+            auto result = conn.execute(shape.sql);
+            if (!result.success) {
+                std::fprintf(stderr, "query failed: %s\n", result.error_message.c_str());
+                std::exit(1);
+            }
+            return static_cast<size_t>(result.row_count);
+        });
+
+        std::printf("%-10s %16.2f %16.2f %9.1fx\n", shape.name, legacy, vectorized, legacy / vectorized);
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * Schema initialization microbenchmark
+ *
+ * Compares the previous fixture loader (one INSERT statement per sample row,
+ * each parsed, planned and materialized through DuckDBConnection::execute)
+ * with SQLExecutor::initialize_schema (one Appender per table).
+ *
+ * Usage: bench-schema-init [repetitions]
+ */
+
+#include "include/sql_executor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sql_practice;
+
+namespace {
+
+/**
+ * @brief Employee-style fixture with the given number of rows
+ */
+QuestionSchema make_schema(size_t rows) {
+    QuestionSchema schema;
+    schema.tables.push_back({"Employee", {
+        {"id", "INTEGER"},
+        {"name", "VARCHAR"},
+        {"salary", "INTEGER"},
+        {"department_id", "INTEGER"}
+    }});
+
+    auto& data = schema.sample_data["Employee"];
+    data.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        data.push_back({
+            {"id", std::to_string(i + 1)},
+            {"name", "Employee O'Brien " + std::to_string(i)},
+            {"salary", std::to_string(50000 + (i * 37) % 100000)},
+            {"department_id", std::to_string(i % 10)}
+        });
+    }
+    return schema;
+}
+
+/**
+ * @brief Previous initialize_schema: CREATE TABLE + one INSERT per row
+ */
+bool legacy_initialize_schema(DuckDBConnection* conn, const QuestionSchema& schema) {
+    for (const auto& table : schema.tables) {
+        std::stringstream sql;
+        sql << "CREATE TABLE " << table.name << " (";
+        for (size_t i = 0; i < table.columns.size(); ++i) {
+            sql << table.columns[i].name << " " << table.columns[i].type;
+            if (i < table.columns.size() - 1) sql << ", ";
+        }
+        sql << ");";
+        if (!conn->execute(sql.str()).success) return false;
+
+        auto it = schema.sample_data.find(table.name);
+        if (it == schema.sample_data.end()) continue;
+
+        for (const auto& row : it->second) {
+            std::stringstream insert_sql;
+            insert_sql << "INSERT INTO " << table.name << " VALUES (";
+            for (size_t i = 0; i < table.columns.size(); ++i) {
+                const auto& col = table.columns[i];
+                auto row_it = row.find(col.name);
+                if (row_it == row.end() || row_it->second == "NULL") {
+                    insert_sql << "NULL";
+                } else if (col.type == "INTEGER" || col.type == "FLOAT") {
+                    insert_sql << row_it->second;
+                } else {
+                    std::string value = row_it->second;
+                    size_t pos = 0;
+                    while ((pos = value.find("'", pos)) != std::string::npos) {
+                        value.replace(pos, 1, "''");
+                        pos += 2;
+                    }
+                    insert_sql << "'" << value << "'";
+                }
+                if (i < table.columns.size() - 1) insert_sql << ", ";
+            }
+            insert_sql << ");";
+            if (!conn->execute(insert_sql.str()).success) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Median wall time in microseconds of init() on fresh connections
+ */
+template <typename InitFn>
+double median_us(int repetitions, InitFn init) {
+    std::vector<double> samples;
+    for (int rep = 0; rep < repetitions; ++rep) {
+        DuckDBConnection conn(":memory:");
+
+        auto start = std::chrono::steady_clock::now();
+        bool ok = init(&conn);
+        auto end = std::chrono::steady_clock::now();
+
+        if (!ok) {
+            std::fprintf(stderr, "initialization failed\n");
+            std::exit(1);
+        }
+        samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int repetitions = argc > 1 ? std::atoi(argv[1]) : 10;
+    if (repetitions <= 0) repetitions = 10;
+
+    SQLExecutor executor;
+    const size_t row_counts[] = {10, 100, 1000, 10000};
+
+    std::printf("Schema init latency (median of %d runs)\n", repetitions);
+    std::printf("%-10s %18s %18s %10s\n", "rows", "per-row INSERT us", "Appender us", "speedup");
+
+    for (size_t rows : row_counts) {
+        auto schema = make_schema(rows);
+
+        double legacy = median_us(repetitions, [&](DuckDBConnection* conn) {
+            return legacy_initialize_schema(conn, schema);
+        });
+        double bulk = median_us(repetitions, [&](DuckDBConnection* conn) {
+            return executor.initialize_schema(conn, schema);
+        });
+
+        std::printf("%-10zu %18.1f %18.1f %9.1fx\n", rows, legacy, bulk, legacy / bulk);
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * Session table scalability benchmark
+ *
+ * Measures SessionManager::get_session and create_session throughput from
+ * 1 to 64 threads with a single-lock table (1 shard, the previous layout)
+ * and with the default sharded table.
+ *
+ * Workloads:
+ *   lookup  every operation is get_session on a random live token
+ *   mixed   every 64th operation is a login (create_session followed by
+ *           terminate_session of that session), the rest are lookups
+ *
+ * Usage: bench-session-table [sessions] [ops_per_thread]
+ */
+
+#include "include/session_manager.hpp"
+#include "include/config.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sql_practice;
+
+namespace {
+
+/**
+ * @brief Operations per second over all threads
+ */
+double run(SessionManager& manager, const std::vector<std::string>& tokens,
+           size_t threads, size_t ops_per_thread, size_t login_every) {
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<size_t> misses{0};
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            std::mt19937_64 rng(t * 7919 + 1);
+            std::uniform_int_distribution<size_t> pick(0, tokens.size() - 1);
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+            }
+
+            for (size_t op = 1; op <= ops_per_thread; ++op) {
+                if (login_every && op % login_every == 0) {
+                    std::string token = manager.create_session("bench");
+                    manager.terminate_session(*SessionToken::parse(token));
+                } else if (!manager.get_session(tokens[pick(rng)])) {
+                    misses.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    while (ready.load() < threads) {
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) worker.join();
+    auto end = std::chrono::steady_clock::now();
+
+    if (misses.load() > 0) {
+        std::fprintf(stderr, "%zu lookups missed\n", misses.load());
+        std::exit(1);
+    }
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(threads * ops_per_thread) / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t sessions = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    size_t ops_per_thread = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+    if (sessions == 0) sessions = 10000;
+    if (ops_per_thread == 0) ops_per_thread = 200000;
+
+    // One shared DuckDB instance, so logins measure the table rather than instance startup
+    Config::max_concurrent_sessions = static_cast<int>(sessions * 2);
+    Config::connections_per_instance = static_cast<int>(sessions * 2);
+
+    const size_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+    const size_t shard_counts[] = {1, SessionManager::DEFAULT_SHARDS};
+
+    for (const char* workload : {"lookup", "mixed"}) {
+        size_t login_every = workload[0] == 'm' ? 64 : 0;
+        std::printf("\n%s workload, %zu sessions, %zu ops/thread (Mops/s)\n", workload, sessions, ops_per_thread);
+        std::printf("%-8s %14s %14s %10s\n", "threads", "1 shard", "64 shards", "speedup");
+
+        std::vector<std::unique_ptr<SessionManager>> managers;
+        std::vector<std::vector<std::string>> tokens;
+        for (size_t shard_count : shard_counts) {
+            managers.push_back(std::make_unique<SessionManager>(3600, shard_count));
+            tokens.emplace_back();
+            for (size_t i = 0; i < sessions; ++i) {
+                tokens.back().push_back(managers.back()->create_session("user" + std::to_string(i)));
+            }
+        }
+
+        for (size_t threads : thread_counts) {
+            double single = run(*managers[0], tokens[0], threads, ops_per_thread, login_every);
+            double sharded = run(*managers[1], tokens[1], threads, ops_per_thread, login_every);
+            std::printf("%-8zu %14.2f %14.2f %9.1fx\n", threads, single / 1e6, sharded / 1e6, sharded / single);
+        }
+    }
+
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <thread>
 #include <cstring>
+#include <cstdlib>
 
 namespace load_test {
 
@@ -178,6 +179,42 @@ TestResult LoadTester::execute_test(const std::string& session_token,
     return result;
 }
 
+void LoadTester::print_instance_load() {
+    std::string response = http_get(server_url + "/health");
+
+    // Response format: {...,"connections_per_instance":N,"instances":[{"id":0,...},...]}
+    size_t list_pos = response.find("\"instances\":[");
+    if (list_pos == std::string::npos) {
+        printf("Instance pool stats not available from /health\n\n");
+        return;
+    }
+
+    auto read_number = [&](const std::string& obj, const char* key) -> long long {
+        std::string needle = std::string("\"") + key + "\":";
+        size_t pos = obj.find(needle);
+        if (pos == std::string::npos) return 0;
+        return std::atoll(obj.c_str() + pos + needle.size());
+    };
+
+    printf("DuckDB instance load (connections per instance: %lld)\n",
+           read_number(response.substr(0, list_pos), "connections_per_instance"));
+    printf("  %-10s %-10s %-10s %-10s\n", "instance", "active", "peak", "total");
+
+    size_t pos = list_pos;
+    while ((pos = response.find('{', pos)) != std::string::npos) {
+        size_t end = response.find('}', pos);
+        if (end == std::string::npos) break;
+        std::string obj = response.substr(pos, end - pos + 1);
+        printf("  %-10lld %-10lld %-10lld %-10lld\n",
+               read_number(obj, "id"),
+               read_number(obj, "active_connections"),
+               read_number(obj, "peak_connections"),
+               read_number(obj, "total_connections"));
+        pos = end + 1;
+    }
+    printf("\n");
+}
+
 std::string LoadTester::http_post(const std::string& url, const std::string& json_data) {
     CURL* curl = curl_easy_init();
     if (!curl) {
@@ -208,6 +245,29 @@ std::string LoadTester::http_post(const std::string& url, const std::string& jso
     return response;
 }
 
+std::string LoadTester::http_get(const std::string& url) {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        return "{\"error\":\"Failed to initialize CURL\"}";
+    }
+
+    std::string response;
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+
+    CURLcode res = curl_easy_perform(curl);
+    curl_easy_cleanup(curl);
+
+    if (res != CURLE_OK) {
+        return "{\"error\":\"" + std::string(curl_easy_strerror(res)) + "\"}";
+    }
+
+    return response;
+}
+
 std::string LoadTester::escape_json(const std::string& str) {
     std::string escaped;
     for (char c : str) {
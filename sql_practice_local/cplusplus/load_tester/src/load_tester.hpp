@@ -126,6 +126,9 @@ public:
     // Run load test
     void run();
 
+    // Print server-side DuckDB instance pool load from /health
+    void print_instance_load();
+
     // Get results
     const LoadTestStats& get_stats() const { return stats; }
 
@@ -140,6 +143,7 @@ private:
 
     // HTTP helper functions
     std::string http_post(const std::string& url, const std::string& json_data);
+    std::string http_get(const std::string& url);
     std::string escape_json(const std::string& str);
 };
 
@@ -46,5 +46,8 @@ int main(int argc, char* argv[]) {
     // Run load test
     tester.run();
 
+    // Show how sessions were spread over the server's DuckDB instances
+    tester.print_instance_load();
+
     return 0;
 }
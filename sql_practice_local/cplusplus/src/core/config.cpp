@@ -1,4 +1,5 @@
-#include "include/session_manager.hpp"
+#include "include/config.hpp"
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 
@@ -12,35 +13,31 @@ int max_concurrent_sessions = 10000;
 int server_port = 8080;
 int thread_pool_size = 32;
 std::string log_level = "info";
+int connections_per_instance = CONNECTIONS_PER_INSTANCE;
+std::string fixture_db_path = "";
+int question_schema_cache_size = 8;
+int max_result_rows = 10000;
+int64_t max_result_bytes = 16 * 1024 * 1024;
+int query_timeout_ms = 5000;
+int query_timeout_easy_ms = 0;
+int query_timeout_medium_ms = 0;
+int query_timeout_hard_ms = 0;
+std::string duckdb_memory_limit = "2GB";
+int duckdb_threads = 0;
+std::string duckdb_temp_directory = "";
+std::string duckdb_max_temp_directory_size = "16GB";
+int query_workers = 0;
+int query_queue_capacity = 256;
+int grade_cache_size = 4096;
+int engine_grade_min_rows = 1000;
 
-// =============================================================================
-// TODO: Shared DuckDB Instance Architecture
-// =============================================================================
-// Current Issue: Each session creates its own DuckDB instance (~24MB virtual memory each)
-// With 1000 sessions = 24GB+ virtual memory (though actual RSS is much lower)
-//
-// Proposed Architecture:
-// - Create N shared DuckDB instances (where N = total_sessions / CONNECTIONS_PER_INSTANCE)
-// - Each session gets a Connection to one of the shared instances
-// - DuckDB can handle many concurrent connections per instance
-//
-// Configurable constant for connections per DuckDB instance
-// Adjust based on benchmarking: test values 100, 250, 500, 1000
-// To determine optimal value: Measure response time, CPU, memory, errors
-constexpr int CONNECTIONS_PER_INSTANCE = 500;
-//
-// Example calculation:
-// - Target: 10,000 concurrent users
-// - Connections per instance: 500
-// - Instances needed: 10,000 / 500 = 20 instances
-// - Memory: 20 * 24MB = 480MB virtual (vs 240GB for separate instances)
-//
-// Implementation approach:
-// 1. Create connection pool managing multiple DuckDB instances
-// 2. Assign each session a connection from the pool (round-robin)
-// 3. Return connections to pool when session expires
-// 4. Use CONNECTIONS_PER_INSTANCE to calculate pool size
-// =============================================================================
+int query_timeout_for(const std::string& difficulty) {
+    int timeout = 0;
+    if (difficulty == "easy") timeout = query_timeout_easy_ms;
+    else if (difficulty == "medium") timeout = query_timeout_medium_ms;
+    else if (difficulty == "hard") timeout = query_timeout_hard_ms;
+    return timeout > 0 ? timeout : query_timeout_ms;
+}
 
 // Load from environment or config file
 void load_config(const std::string& config_file) {
@@ -60,6 +57,57 @@ void load_config(const std::string& config_file) {
     if (const char* env_log = std::getenv("LOG_LEVEL")) {
         log_level = env_log;
     }
+    if (const char* env_per_instance = std::getenv("CONNECTIONS_PER_INSTANCE")) {
+        connections_per_instance = std::stoi(env_per_instance);
+    }
+    if (const char* env_fixture_path = std::getenv("FIXTURE_DB_PATH")) {
+        fixture_db_path = env_fixture_path;
+    }
+    if (const char* env_schema_cache = std::getenv("QUESTION_SCHEMA_CACHE")) {
+        question_schema_cache_size = std::stoi(env_schema_cache);
+    }
+    if (const char* env_max_rows = std::getenv("MAX_RESULT_ROWS")) {
+        max_result_rows = std::stoi(env_max_rows);
+    }
+    if (const char* env_max_bytes = std::getenv("MAX_RESULT_BYTES")) {
+        max_result_bytes = std::stoll(env_max_bytes);
+    }
+    if (const char* env_query_timeout = std::getenv("QUERY_TIMEOUT_MS")) {
+        query_timeout_ms = std::stoi(env_query_timeout);
+    }
+    if (const char* env_timeout_easy = std::getenv("QUERY_TIMEOUT_EASY_MS")) {
+        query_timeout_easy_ms = std::stoi(env_timeout_easy);
+    }
+    if (const char* env_timeout_medium = std::getenv("QUERY_TIMEOUT_MEDIUM_MS")) {
+        query_timeout_medium_ms = std::stoi(env_timeout_medium);
+    }
+    if (const char* env_timeout_hard = std::getenv("QUERY_TIMEOUT_HARD_MS")) {
+        query_timeout_hard_ms = std::stoi(env_timeout_hard);
+    }
+    if (const char* env_memory_limit = std::getenv("DUCKDB_MEMORY_LIMIT")) {
+        duckdb_memory_limit = env_memory_limit;
+    }
+    if (const char* env_duckdb_threads = std::getenv("DUCKDB_THREADS")) {
+        duckdb_threads = std::stoi(env_duckdb_threads);
+    }
+    if (const char* env_temp_dir = std::getenv("DUCKDB_TEMP_DIRECTORY")) {
+        duckdb_temp_directory = env_temp_dir;
+    }
+    if (const char* env_max_temp = std::getenv("DUCKDB_MAX_TEMP_DIRECTORY_SIZE")) {
+        duckdb_max_temp_directory_size = env_max_temp;
+    }
+    if (const char* env_query_workers = std::getenv("QUERY_WORKERS")) {
+        query_workers = std::stoi(env_query_workers);
+    }
+    if (const char* env_queue_capacity = std::getenv("QUERY_QUEUE_CAPACITY")) {
+        query_queue_capacity = std::stoi(env_queue_capacity);
+    }
+    if (const char* env_grade_cache = std::getenv("GRADE_CACHE_SIZE")) {
+        grade_cache_size = std::stoi(env_grade_cache);
+    }
+    if (const char* env_engine_grade = std::getenv("ENGINE_GRADE_MIN_ROWS")) {
+        engine_grade_min_rows = std::stoi(env_engine_grade);
+    }
 
     // Optionally load from file
     if (!config_file.empty()) {
@@ -85,6 +133,23 @@ void load_config(const std::string& config_file) {
                     else if (key == "MAX_SESSIONS") max_concurrent_sessions = std::stoi(value);
                     else if (key == "THREAD_POOL_SIZE") thread_pool_size = std::stoi(value);
                     else if (key == "LOG_LEVEL") log_level = value;
+                    else if (key == "CONNECTIONS_PER_INSTANCE") connections_per_instance = std::stoi(value);
+                    else if (key == "FIXTURE_DB_PATH") fixture_db_path = value;
+                    else if (key == "QUESTION_SCHEMA_CACHE") question_schema_cache_size = std::stoi(value);
+                    else if (key == "MAX_RESULT_ROWS") max_result_rows = std::stoi(value);
+                    else if (key == "MAX_RESULT_BYTES") max_result_bytes = std::stoll(value);
+                    else if (key == "QUERY_TIMEOUT_MS") query_timeout_ms = std::stoi(value);
+                    else if (key == "QUERY_TIMEOUT_EASY_MS") query_timeout_easy_ms = std::stoi(value);
+                    else if (key == "QUERY_TIMEOUT_MEDIUM_MS") query_timeout_medium_ms = std::stoi(value);
+                    else if (key == "QUERY_TIMEOUT_HARD_MS") query_timeout_hard_ms = std::stoi(value);
+                    else if (key == "DUCKDB_MEMORY_LIMIT") duckdb_memory_limit = value;
+                    else if (key == "DUCKDB_THREADS") duckdb_threads = std::stoi(value);
+                    else if (key == "DUCKDB_TEMP_DIRECTORY") duckdb_temp_directory = value;
+                    else if (key == "DUCKDB_MAX_TEMP_DIRECTORY_SIZE") duckdb_max_temp_directory_size = value;
+                    else if (key == "QUERY_WORKERS") query_workers = std::stoi(value);
+                    else if (key == "QUERY_QUEUE_CAPACITY") query_queue_capacity = std::stoi(value);
+                    else if (key == "GRADE_CACHE_SIZE") grade_cache_size = std::stoi(value);
+                    else if (key == "ENGINE_GRADE_MIN_ROWS") engine_grade_min_rows = std::stoi(value);
                 }
             }
         }
@@ -0,0 +1,43 @@
+#include "include/expiry_wheel.hpp"
+#include <algorithm>
+
+namespace sql_practice {
+
+// =============================================================================
+// ExpiryWheel Implementation
+// =============================================================================
+
+void ExpiryWheel::schedule(const SessionToken& token, uint64_t deadline_tick) {
+    constexpr uint64_t span = uint64_t(1) << (LEVEL_BITS * LEVELS);
+    place(Entry{token, std::min(std::max(deadline_tick, now + 1), now + span - 1)});
+    count++;
+}
+
+void ExpiryWheel::place(const Entry& entry) {
+    // Lowest level where deadline and now agree on every higher bit; a
+    // cascaded entry due at the current tick lands in the slot fired next
+    int level = 0;
+    while (level < LEVELS - 1 &&
+           (entry.deadline >> (LEVEL_BITS * (level + 1))) != (now >> (LEVEL_BITS * (level + 1)))) {
+        level++;
+    }
+    size_t slot = static_cast<size_t>(entry.deadline >> (LEVEL_BITS * level)) & (SLOTS - 1);
+    slots[level][slot].push_back(entry);
+}
+
+void ExpiryWheel::tick() {
+    now++;
+
+    // Highest level first, so its entries can land in a lower slot cascaded next
+    for (int level = LEVELS - 1; level > 0; --level) {
+        uint64_t boundary = (uint64_t(1) << (LEVEL_BITS * level)) - 1;
+        if ((now & boundary) != 0) continue;
+
+        auto& slot = slots[level][static_cast<size_t>(now >> (LEVEL_BITS * level)) & (SLOTS - 1)];
+        std::vector<Entry> moving;
+        moving.swap(slot);
+        for (const auto& entry : moving) place(entry);
+    }
+}
+
+} // namespace sql_practice
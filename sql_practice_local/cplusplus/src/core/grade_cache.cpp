@@ -0,0 +1,90 @@
+#include "include/grade_cache.hpp"
+
+namespace sql_practice {
+
+// =============================================================================
+// GradeCache Implementation
+// =============================================================================
+
+GradeCache::GradeCache(size_t max_entries)
+    : capacity(max_entries), hits(0), misses(0), coalesced(0) {
+}
+
+std::shared_ptr<const GradeResponse> GradeCache::get_or_compute(
+    const GradeKey& key,
+    const std::function<GradeResponse()>& compute,
+    bool& cached
+) {
+    std::promise<std::shared_ptr<const GradeResponse>> promise;
+    {
+        std::unique_lock<std::mutex> lock(cache_mutex);
+
+        auto it = index.find(key);
+        if (it != index.end()) {
+            order.splice(order.begin(), order, it->second);
+            hits.fetch_add(1, std::memory_order_relaxed);
+            cached = true;
+            return it->second->second;
+        }
+
+        auto flight = in_flight.find(key);
+        if (flight != in_flight.end()) {
+            auto future = flight->second;
+            lock.unlock();
+            coalesced.fetch_add(1, std::memory_order_relaxed);
+            cached = true;
+            return future.get();
+        }
+
+        in_flight.emplace(key, promise.get_future().share());
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+    cached = false;
+
+    std::shared_ptr<const GradeResponse> response;
+    try {
+        response = std::make_shared<const GradeResponse>(compute());
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            in_flight.erase(key);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        if (response->cacheable) {
+            store(key, response);
+        }
+        in_flight.erase(key);
+    }
+    promise.set_value(response);
+    return response;
+}
+
+void GradeCache::store(const GradeKey& key, std::shared_ptr<const GradeResponse> response) {
+    if (capacity == 0) return;
+
+    order.emplace_front(key, std::move(response));
+    index[key] = order.begin();
+
+    while (order.size() > capacity) {
+        index.erase(order.back().first);
+        order.pop_back();
+    }
+}
+
+GradeCacheStats GradeCache::get_stats() const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return GradeCacheStats{
+        order.size(),
+        hits.load(std::memory_order_relaxed),
+        misses.load(std::memory_order_relaxed),
+        coalesced.load(std::memory_order_relaxed)
+    };
+}
+
+} // namespace sql_practice
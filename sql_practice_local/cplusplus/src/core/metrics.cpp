@@ -0,0 +1,187 @@
+#include "include/metrics.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace sql_practice {
+
+size_t metric_shard() {
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+
+// =============================================================================
+// ShardedCounter / LatencyHistogram Implementation
+// =============================================================================
+
+uint64_t ShardedCounter::value() const {
+    uint64_t total = 0;
+    for (const auto& slot : slots) {
+        total += slot.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t LatencyHistogram::bucket_for(int64_t us) {
+    if (us < static_cast<int64_t>(SUB_BUCKETS)) return us < 0 ? 0 : static_cast<size_t>(us);
+
+    uint64_t value = static_cast<uint64_t>(us);
+    int magnitude = 63 - __builtin_clzll(value);
+    if (magnitude > MAX_MAGNITUDE) return BUCKET_COUNT - 1;  // Magnitude MAX_MAGNITUDE fills the last row
+
+    // Top SUB_BUCKET_BITS bits below the leading one pick the sub-bucket
+    size_t sub = static_cast<size_t>(value >> (magnitude - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+    return static_cast<size_t>(magnitude - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucket_upper_us(size_t bucket) {
+    if (bucket < SUB_BUCKETS) return bucket;
+    int magnitude = static_cast<int>(bucket / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+    uint64_t sub = bucket % SUB_BUCKETS;
+    int shift = magnitude - SUB_BUCKET_BITS;
+    return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(int64_t us) {
+    auto& shard = shards[metric_shard()];
+    shard.counts[bucket_for(us)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum_us.fetch_add(static_cast<uint64_t>(us < 0 ? 0 : us), std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot merged;
+    for (const auto& shard : shards) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            uint64_t count = shard.counts[i].load(std::memory_order_relaxed);
+            merged.counts[i] += count;
+            merged.count += count;
+        }
+        merged.sum_us += shard.sum_us.load(std::memory_order_relaxed);
+    }
+    return merged;
+}
+
+void RouteMetrics::record(int status_code, int64_t us) {
+    if (status_code >= 500) responses_5xx.add();
+    else if (status_code >= 400) responses_4xx.add();
+    else responses_2xx.add();
+    latency.record(us);
+}
+
+// =============================================================================
+// Metrics Implementation
+// =============================================================================
+
+Metrics& Metrics::shared() {
+    static Metrics metrics;
+    return metrics;
+}
+
+RouteMetrics* Metrics::route(const std::string& name) {
+    std::lock_guard<std::mutex> lock(routes_mutex);
+    for (auto& route : routes) {
+        if (route.route == name) return &route;
+    }
+    routes.emplace_back(name);
+    return &routes.back();
+}
+
+// =============================================================================
+// PrometheusWriter Implementation
+// =============================================================================
+
+void PrometheusWriter::family(const char* name, const char* type, const char* help) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+static void append_series(std::string& out, const char* name, const char* suffix, const std::string& labels) {
+    out += name;
+    out += suffix;
+    if (!labels.empty()) {
+        out += '{';
+        out += labels;
+        out += '}';
+    }
+    out += ' ';
+}
+
+void PrometheusWriter::sample(const char* name, const std::string& labels, double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    append_series(out, name, "", labels);
+    out.append(buffer, static_cast<size_t>(length));
+    out += '\n';
+}
+
+void PrometheusWriter::sample(const char* name, const std::string& labels, uint64_t value) {
+    append_series(out, name, "", labels);
+    out += std::to_string(value);
+    out += '\n';
+}
+
+void PrometheusWriter::histogram(const char* name, const std::string& labels,
+                                 const LatencyHistogram& histogram) {
+    auto snapshot = histogram.snapshot();
+    std::string prefix = labels.empty() ? std::string() : labels + ",";
+
+    // The same le bounds on every scrape, empty or not, so rate() and
+    // histogram_quantile() see a stable series set
+    uint64_t cumulative = 0;
+    char le[32];
+    for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+        cumulative += snapshot.counts[i];
+        if (i % LatencyHistogram::EXPORT_STRIDE != LatencyHistogram::EXPORT_STRIDE - 1) continue;
+        // Integer microseconds, so the inclusive upper bound is exact in seconds
+        std::snprintf(le, sizeof(le), "%.6f", static_cast<double>(LatencyHistogram::bucket_upper_us(i)) / 1e6);
+        append_series(out, name, "_bucket", prefix + "le=\"" + le + "\"");
+        out += std::to_string(cumulative);
+        out += '\n';
+    }
+    append_series(out, name, "_bucket", prefix + "le=\"+Inf\"");
+    out += std::to_string(snapshot.count);
+    out += '\n';
+
+    append_series(out, name, "_sum", labels);
+    char sum[32];
+    int length = std::snprintf(sum, sizeof(sum), "%.6f", static_cast<double>(snapshot.sum_us) / 1e6);
+    out.append(sum, static_cast<size_t>(length));
+    out += '\n';
+
+    append_series(out, name, "_count", labels);
+    out += std::to_string(snapshot.count);
+    out += '\n';
+}
+
+std::string PrometheusWriter::label_value(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\') escaped += "\\\\";
+        else if (c == '"') escaped += "\\\"";
+        else if (c == '\n') escaped += "\\n";
+        else escaped += c;
+    }
+    return escaped;
+}
+
+size_t process_thread_count() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 8, "Threads:") == 0) {
+            return static_cast<size_t>(std::strtoul(line.c_str() + 8, nullptr, 10));
+        }
+    }
+    return 0;
+}
+
+} // namespace sql_practice
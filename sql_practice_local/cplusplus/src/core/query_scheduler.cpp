@@ -0,0 +1,75 @@
+#include "include/query_scheduler.hpp"
+#include <algorithm>
+
+namespace sql_practice {
+
+// =============================================================================
+// QueryScheduler Implementation
+// =============================================================================
+
+QueryScheduler::QueryScheduler(size_t worker_count, size_t capacity)
+    : queue_capacity(std::max<size_t>(capacity, 1)), stopping(false),
+      busy_workers(0), rejected_count(0) {
+    if (worker_count == 0) {
+        worker_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+QueryScheduler::~QueryScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+        queue.clear();
+    }
+    queue_cv.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+bool QueryScheduler::try_enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (stopping || queue.size() >= queue_capacity) {
+            rejected_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        queue.push_back(std::move(task));
+    }
+    queue_cv.notify_one();
+    return true;
+}
+
+void QueryScheduler::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (stopping) return;
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        busy_workers.fetch_add(1, std::memory_order_relaxed);
+        task();
+        busy_workers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+size_t QueryScheduler::get_queue_depth() const {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    return queue.size();
+}
+
+bool QueryScheduler::is_ready() const {
+    return get_queue_depth() * 4 < queue_capacity * 3;
+}
+
+} // namespace sql_practice
@@ -0,0 +1,96 @@
+#include "include/request_timing.hpp"
+#include <cstdio>
+#include <ctime>
+
+namespace sql_practice {
+
+const char* request_phase_name(RequestPhase phase) {
+    switch (phase) {
+        case RequestPhase::BODY_READ: return "body";
+        case RequestPhase::JSON_PARSE: return "parse";
+        case RequestPhase::SESSION_LOOKUP: return "session";
+        case RequestPhase::QUEUE_WAIT: return "queue";
+        case RequestPhase::SCHEMA_INIT: return "schema";
+        case RequestPhase::VALIDATION: return "validate";
+        case RequestPhase::EXECUTION: return "exec";
+        case RequestPhase::FETCH: return "fetch";
+        case RequestPhase::GRADING: return "grade";
+        case RequestPhase::SERIALIZATION: return "serialize";
+    }
+    return "unknown";
+}
+
+int64_t thread_cpu_us() {
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief Append "name;dur=<ms with 3 decimals>"
+ */
+static void append_metric(std::string& out, const char* name, int64_t us) {
+    char buffer[64];
+    int length = std::snprintf(buffer, sizeof(buffer), "%s;dur=%lld.%03lld", name,
+                               static_cast<long long>(us / 1000), static_cast<long long>(us % 1000));
+    if (!out.empty()) out += ", ";
+    out.append(buffer, static_cast<size_t>(length));
+}
+
+std::string RequestTiming::server_timing() const {
+    std::string header;
+    header.reserve(256);
+    for (size_t i = 0; i < REQUEST_PHASE_COUNT; ++i) {
+        append_metric(header, request_phase_name(static_cast<RequestPhase>(i)), phase_us[i]);
+    }
+    append_metric(header, "cpu", cpu_us);
+    append_metric(header, "total", total_us);
+    return header;
+}
+
+// =============================================================================
+// RequestTimingStats Implementation
+// =============================================================================
+
+RequestTimingStats& RequestTimingStats::shared() {
+    static RequestTimingStats stats;
+    return stats;
+}
+
+void RequestTimingStats::add(Slot& slot, int64_t us) {
+    slot.total_us.fetch_add(us, std::memory_order_relaxed);
+    int64_t seen = slot.max_us.load(std::memory_order_relaxed);
+    while (us > seen && !slot.max_us.compare_exchange_weak(seen, us, std::memory_order_relaxed)) {
+    }
+}
+
+void RequestTimingStats::record(const RequestTiming& timing) {
+    request_count.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < REQUEST_PHASE_COUNT; ++i) {
+        add(phases[i], timing.phase_us[i]);
+    }
+    add(cpu, timing.cpu_us);
+    add(total, timing.total_us);
+}
+
+std::string RequestTimingStats::to_json() const {
+    uint64_t requests = request_count.load(std::memory_order_relaxed);
+
+    auto slot_json = [requests](const Slot& slot) {
+        int64_t sum = slot.total_us.load(std::memory_order_relaxed);
+        return "{\"avg_us\":" + std::to_string(requests ? sum / static_cast<int64_t>(requests) : 0) +
+               ",\"max_us\":" + std::to_string(slot.max_us.load(std::memory_order_relaxed)) + "}";
+    };
+
+    std::string json = "{\"requests\":" + std::to_string(requests) + ",\"phases\":{";
+    for (size_t i = 0; i < REQUEST_PHASE_COUNT; ++i) {
+        if (i > 0) json += ",";
+        json += "\"";
+        json += request_phase_name(static_cast<RequestPhase>(i));
+        json += "\":" + slot_json(phases[i]);
+    }
+    json += "},\"cpu\":" + slot_json(cpu) + ",\"total\":" + slot_json(total) + "}";
+    return json;
+}
+
+} // namespace sql_practice
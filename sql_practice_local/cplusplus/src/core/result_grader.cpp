@@ -0,0 +1,66 @@
+#include "include/result_grader.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace sql_practice {
+
+GradeMode grade_mode_from(const std::string& name) {
+    return name == "ordered" ? GradeMode::ORDERED : GradeMode::UNORDERED;
+}
+
+/**
+ * @brief Hash of a whole row, consistent with QueryResult::row_equals
+ */
+static uint64_t row_hash(const QueryResult& result, size_t row) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const auto& column : result.data) {
+        hash ^= column.hash(row) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+bool grade_result(const QueryResult& actual, const QueryResult& expected, GradeMode mode) {
+    if (actual.truncated) return false;
+    if (actual.columns != expected.columns) return false;
+    if (actual.row_count != expected.row_count) return false;
+    if (actual.data.size() != expected.data.size()) return false;
+
+    size_t rows = static_cast<size_t>(actual.row_count);
+
+    if (mode == GradeMode::ORDERED) {
+        for (size_t row = 0; row < rows; ++row) {
+            if (!actual.row_equals(row, expected, row)) return false;
+        }
+        return true;
+    }
+
+    // Multiset of expected rows: hash -> rows not yet matched
+    std::unordered_map<uint64_t, std::vector<size_t>> remaining;
+    remaining.reserve(rows);
+    for (size_t row = 0; row < rows; ++row) {
+        remaining[row_hash(expected, row)].push_back(row);
+    }
+
+    for (size_t row = 0; row < rows; ++row) {
+        auto it = remaining.find(row_hash(actual, row));
+        if (it == remaining.end()) return false;
+
+        // Equal hashes are confirmed cell by cell; each expected row is used once
+        auto& candidates = it->second;
+        bool matched = false;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (actual.row_equals(row, expected, candidates[i])) {
+                candidates[i] = candidates.back();
+                candidates.pop_back();
+                matched = true;
+                break;
+            }
+        }
+        if (!matched) return false;
+        if (candidates.empty()) remaining.erase(it);
+    }
+
+    return true;
+}
+
+} // namespace sql_practice
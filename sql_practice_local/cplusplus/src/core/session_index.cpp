@@ -0,0 +1,81 @@
+#include "include/session_index.hpp"
+
+namespace sql_practice {
+
+// =============================================================================
+// SessionIndex Implementation
+// =============================================================================
+
+SessionIndex::SessionIndex(size_t initial_capacity) : mask(0), count(0) {
+    size_t capacity = 8;
+    while (capacity < initial_capacity) capacity <<= 1;
+    slots.resize(capacity);
+    mask = capacity - 1;
+}
+
+std::shared_ptr<UserSession> SessionIndex::find(const SessionToken& token) const {
+    if (token.empty()) return nullptr;
+    for (size_t i = home(token);; i = (i + 1) & mask) {
+        const Slot& slot = slots[i];
+        if (slot.key == token) return slot.session;
+        if (slot.key.empty()) return nullptr;
+    }
+}
+
+void SessionIndex::insert(const SessionToken& token, std::shared_ptr<UserSession> session) {
+    if (token.empty()) return;
+    if ((count + 1) * 4 > slots.size() * 3) grow();
+
+    for (size_t i = home(token);; i = (i + 1) & mask) {
+        Slot& slot = slots[i];
+        if (slot.key == token) {
+            slot.session = std::move(session);
+            return;
+        }
+        if (slot.key.empty()) {
+            slot.key = token;
+            slot.session = std::move(session);
+            count++;
+            return;
+        }
+    }
+}
+
+std::shared_ptr<UserSession> SessionIndex::erase(const SessionToken& token) {
+    if (token.empty()) return nullptr;
+
+    size_t hole = home(token);
+    while (slots[hole].key != token) {
+        if (slots[hole].key.empty()) return nullptr;
+        hole = (hole + 1) & mask;
+    }
+
+    auto removed = std::move(slots[hole].session);
+    slots[hole].key = SessionToken{};
+    count--;
+
+    // Backward shift: pull later entries of the run into the hole when
+    // their home position does not lie cyclically in (hole, i]
+    for (size_t i = (hole + 1) & mask; !slots[i].key.empty(); i = (i + 1) & mask) {
+        size_t ideal = home(slots[i].key);
+        bool stays = hole <= i ? (hole < ideal && ideal <= i) : (hole < ideal || ideal <= i);
+        if (stays) continue;
+
+        slots[hole] = std::move(slots[i]);
+        slots[i].key = SessionToken{};
+        hole = i;
+    }
+    return removed;
+}
+
+void SessionIndex::grow() {
+    std::vector<Slot> old(slots.size() * 2);
+    old.swap(slots);
+    mask = slots.size() - 1;
+    count = 0;
+    for (auto& slot : old) {
+        if (!slot.key.empty()) insert(slot.key, std::move(slot.session));
+    }
+}
+
+} // namespace sql_practice
@@ -1,76 +1,178 @@
 #include "include/session_manager.hpp"
 #include "include/sql_executor.hpp"
-#include <random>
-#include <sstream>
-#include <iomanip>
+#include "include/config.hpp"
+#include "include/metrics.hpp"
+#include "include/token_generator.hpp"
 #include <algorithm>
 #include <mutex>
 
 namespace sql_practice {
 
+/**
+ * @brief Smallest power of two >= n (at least 1)
+ */
+static size_t round_up_pow2(size_t n) {
+    size_t pow2 = 1;
+    while (pow2 < n) pow2 <<= 1;
+    return pow2;
+}
+
+/**
+ * @brief Session instance pool sized from Config
+ *
+ * The in-engine grader (Config::engine_grade_min_rows > 0) runs one more
+ * instance, which takes its own share of the DuckDB budget.
+ */
+static std::shared_ptr<DuckDBInstancePool> make_session_pool() {
+    size_t instances = DuckDBInstancePool::instances_for(Config::max_concurrent_sessions,
+                                                         Config::connections_per_instance);
+    size_t shares = instances + (Config::engine_grade_min_rows > 0 ? 1 : 0);
+    return std::make_shared<DuckDBInstancePool>(instances, Config::connections_per_instance, shares);
+}
+
+SessionManager::SessionManager(int timeout_sec, size_t shard_count)
+    : shard_mask(round_up_pow2(shard_count) - 1),
+      session_timeout_seconds(timeout_sec),
+      instance_pool(make_session_pool()),
+      expiry_epoch(std::chrono::steady_clock::now()),
+      expiry_stopping(false) {
+    shards = std::make_unique<Shard[]>(shard_mask + 1);
+    expiry_thread = std::thread([this]() { expiry_loop(); });
+}
+
+SessionManager::~SessionManager() {
+    {
+        std::lock_guard<std::mutex> lock(expiry_mutex);
+        expiry_stopping = true;
+    }
+    expiry_cv.notify_all();
+    if (expiry_thread.joinable()) {
+        expiry_thread.join();
+    }
+}
+
 std::string SessionManager::create_session(const std::string& user_id) {
     // Generate unique session token
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 15);
-
-    std::stringstream ss;
-    ss << "sess_";
-    for (int i = 0; i < 32; ++i) {
-        ss << std::hex << dis(gen);
-    }
-    std::string token = ss.str();
+    SessionToken token = TokenGenerator::next();
 
-    // Create session
-    SQLExecutor executor;
+    // Create session on a pooled DuckDB instance
+    SQLExecutor executor(instance_pool);
     auto session = std::make_shared<UserSession>(user_id, token);
     session->db_conn = executor.create_connection();
 
     // Store session
     {
-        std::unique_lock lock(sessions_mutex);
-        sessions[token] = session;
+        auto& shard = shard_for(token);
+        std::unique_lock lock(shard.mutex);
+        shard.sessions.insert(token, session);
     }
+    session_count.fetch_add(1, std::memory_order_relaxed);
+    arm_expiry(token, session->get_last_activity());
+    Metrics::shared().sessions_created.add();
 
-    return token;
+    return token.to_string();
 }
 
-std::shared_ptr<UserSession> SessionManager::get_session(const std::string& token) {
-    std::shared_lock lock(sessions_mutex);
-    auto it = sessions.find(token);
-    if (it != sessions.end()) {
-        return it->second;
-    }
-    return nullptr;
+std::shared_ptr<UserSession> SessionManager::get_session(const SessionToken& token) const {
+    auto& shard = shard_for(token);
+    std::shared_lock lock(shard.mutex);
+    return shard.sessions.find(token);
 }
 
-size_t SessionManager::cleanup_expired() {
-    std::vector<std::string> expired_tokens;
+std::shared_ptr<UserSession> SessionManager::get_session(std::string_view token) const {
+    auto decoded = SessionToken::parse(token);
+    return decoded ? get_session(*decoded) : nullptr;
+}
 
-    // Find expired sessions
+uint64_t SessionManager::expiry_tick_for(std::chrono::steady_clock::time_point last_activity) const {
+    // is_expired() needs more than timeout whole seconds, so one tick past last_activity + timeout
+    auto since_epoch = std::chrono::ceil<std::chrono::seconds>(last_activity - expiry_epoch).count();
+    return static_cast<uint64_t>(std::max<int64_t>(since_epoch, 0)) +
+           static_cast<uint64_t>(std::max(session_timeout_seconds, 0)) + 1;
+}
+
+void SessionManager::arm_expiry(const SessionToken& token,
+                                std::chrono::steady_clock::time_point last_activity) {
+    uint64_t deadline = expiry_tick_for(last_activity);
+    std::lock_guard<std::mutex> lock(expiry_mutex);
+    expiry_wheel.schedule(token, deadline);
+}
+
+size_t SessionManager::expire_due(uint64_t now_tick) {
+    std::vector<SessionToken> due;
     {
-        std::shared_lock lock(sessions_mutex);
-        for (const auto& [token, session] : sessions) {
-            if (session->is_expired(session_timeout_seconds)) {
-                expired_tokens.push_back(token);
-            }
-        }
+        std::lock_guard<std::mutex> lock(expiry_mutex);
+        expiry_wheel.advance(now_tick, [&](const SessionToken& token) { due.push_back(token); });
     }
+    if (due.empty()) return 0;
 
-    // Remove expired sessions
-    {
-        std::unique_lock lock(sessions_mutex);
-        for (const auto& token : expired_tokens) {
-            sessions.erase(token);
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<UserSession>> expired;
+    std::vector<std::pair<SessionToken, std::chrono::steady_clock::time_point>> still_active;
+
+    for (const auto& token : due) {
+        auto& shard = shard_for(token);
+        std::unique_lock lock(shard.mutex);
+
+        // Terminated sessions leave their entry behind; it is simply dropped here
+        auto session = shard.sessions.find(token);
+        if (!session) continue;
+
+        if (!session->is_expired(session_timeout_seconds)) {
+            still_active.emplace_back(token, session->get_last_activity());
+            continue;
         }
+
+        expired.push_back(shard.sessions.erase(token));
+    }
+
+    size_t removed = expired.size();
+    session_count.fetch_sub(removed, std::memory_order_relaxed);
+
+    // Connections (and their pool leases) are released on the reaper thread
+    reaper.enqueue(std::move(expired));
+
+    for (const auto& [token, last_activity] : still_active) {
+        arm_expiry(token, last_activity);
     }
 
-    return expired_tokens.size();
+    auto& metrics = Metrics::shared();
+    metrics.sessions_expired.add(removed);
+    metrics.session_cleanup.record(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started
+    ).count());
+
+    return removed;
 }
 
-void SessionManager::terminate_session(const std::string& token) {
-    std::unique_lock lock(sessions_mutex);
-    sessions.erase(token);
+void SessionManager::expiry_loop() {
+    std::unique_lock<std::mutex> lock(expiry_mutex);
+    while (!expiry_stopping) {
+        auto next_tick = expiry_epoch + std::chrono::seconds(expiry_wheel.current_tick() + 1);
+        if (expiry_cv.wait_until(lock, next_tick, [this]() { return expiry_stopping; })) break;
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - expiry_epoch);
+        uint64_t now_tick = static_cast<uint64_t>(elapsed.count());
+
+        lock.unlock();
+        expire_due(now_tick);
+        lock.lock();
+    }
+}
+
+void SessionManager::terminate_session(const SessionToken& token) {
+    std::shared_ptr<UserSession> session;
+    {
+        auto& shard = shard_for(token);
+        std::unique_lock lock(shard.mutex);
+        session = shard.sessions.erase(token);
+    }
+    if (session) {
+        session_count.fetch_sub(1, std::memory_order_relaxed);
+        Metrics::shared().sessions_terminated.add();
+        reaper.enqueue(std::move(session));
+    }
 }
 
 } // namespace sql_practice
@@ -0,0 +1,87 @@
+#include "include/session_reaper.hpp"
+#include "include/session_manager.hpp"
+#include "include/metrics.hpp"
+#include <chrono>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace sql_practice {
+
+// =============================================================================
+// SessionReaper Implementation
+// =============================================================================
+
+SessionReaper::SessionReaper() : stopping(false), backlog(0), reaped(0) {
+    worker = std::thread([this]() { run(); });
+}
+
+SessionReaper::~SessionReaper() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    queue_cv.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void SessionReaper::enqueue(std::shared_ptr<UserSession> session) {
+    if (!session) return;
+    {
+        // Counted under the lock, before the reaper can take the session and count it down
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        queue.push_back(std::move(session));
+        backlog.fetch_add(1, std::memory_order_relaxed);
+    }
+    queue_cv.notify_one();
+}
+
+void SessionReaper::enqueue(std::vector<std::shared_ptr<UserSession>> sessions) {
+    if (sessions.empty()) return;
+    size_t count = sessions.size();
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (queue.empty()) {
+            queue.swap(sessions);
+        } else {
+            for (auto& session : sessions) queue.push_back(std::move(session));
+        }
+        backlog.fetch_add(count, std::memory_order_relaxed);
+    }
+    queue_cv.notify_one();
+}
+
+void SessionReaper::run() {
+#ifdef __linux__
+    // Per-thread nice value: teardown yields to request and query threads
+    setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), 10);
+#endif
+
+    std::vector<std::shared_ptr<UserSession>> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) return;  // Stopping and drained
+            batch.swap(queue);
+        }
+
+        auto started = std::chrono::steady_clock::now();
+        for (auto& session : batch) {
+            session.reset();
+            backlog.fetch_sub(1, std::memory_order_relaxed);
+        }
+        reaped.fetch_add(batch.size(), std::memory_order_relaxed);
+        Metrics::shared().session_teardown.record(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started
+        ).count());
+        batch.clear();
+    }
+}
+
+} // namespace sql_practice
@@ -0,0 +1,88 @@
+#include "include/session_token.hpp"
+
+namespace sql_practice {
+
+namespace {
+
+/**
+ * @brief Value of each byte as a lowercase hex digit, -1 otherwise
+ */
+struct HexDecodeTable {
+    int8_t values[256];
+
+    constexpr HexDecodeTable() : values() {
+        for (int i = 0; i < 256; ++i) values[i] = -1;
+        for (int i = 0; i < 10; ++i) values['0' + i] = static_cast<int8_t>(i);
+        for (int i = 0; i < 6; ++i) values['a' + i] = static_cast<int8_t>(10 + i);
+    }
+};
+
+/**
+ * @brief Two lowercase hex digits for each byte value
+ */
+struct HexEncodeTable {
+    char pairs[256][2];
+
+    constexpr HexEncodeTable() : pairs() {
+        constexpr char digits[] = "0123456789abcdef";
+        for (int i = 0; i < 256; ++i) {
+            pairs[i][0] = digits[i >> 4];
+            pairs[i][1] = digits[i & 0x0f];
+        }
+    }
+};
+
+constexpr HexDecodeTable HEX_DECODE;
+constexpr HexEncodeTable HEX_ENCODE;
+
+/**
+ * @brief Decode 16 hex digits; false on any non-digit
+ */
+bool decode_u64(const char* digits, uint64_t& out) {
+    uint64_t value = 0;
+    int8_t invalid = 0;
+    for (int i = 0; i < 16; ++i) {
+        int8_t digit = HEX_DECODE.values[static_cast<unsigned char>(digits[i])];
+        invalid |= digit;  // Any -1 sets the sign bit
+        value = (value << 4) | static_cast<uint64_t>(digit & 0x0f);
+    }
+    out = value;
+    return invalid >= 0;
+}
+
+/**
+ * @brief Encode as 16 hex digits, one table lookup per byte
+ */
+void encode_u64(uint64_t value, char* out) {
+    for (int i = 7; i >= 0; --i) {
+        const char* pair = HEX_ENCODE.pairs[value & 0xff];
+        out[2 * i] = pair[0];
+        out[2 * i + 1] = pair[1];
+        value >>= 8;
+    }
+}
+
+} // namespace
+
+std::optional<SessionToken> SessionToken::parse(std::string_view text) {
+    if (text.size() != WIRE_LENGTH || text.compare(0, PREFIX.size(), PREFIX) != 0) {
+        return std::nullopt;
+    }
+
+    SessionToken token;
+    const char* digits = text.data() + PREFIX.size();
+    if (!decode_u64(digits, token.hi) || !decode_u64(digits + 16, token.lo) || token.empty()) {
+        return std::nullopt;
+    }
+    return token;
+}
+
+std::string SessionToken::to_string() const {
+    std::string text(WIRE_LENGTH, '\0');
+    text.replace(0, PREFIX.size(), PREFIX.data(), PREFIX.size());
+    encode_u64(hi, &text[PREFIX.size()]);
+    encode_u64(lo, &text[PREFIX.size() + 16]);
+    return text;
+}
+
+} // namespace sql_practice
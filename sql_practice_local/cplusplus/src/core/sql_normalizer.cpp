@@ -0,0 +1,190 @@
+#include "include/sql_normalizer.hpp"
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+#include <vector>
+
+namespace sql_practice {
+
+// =============================================================================
+// SQL Normalizer
+// =============================================================================
+
+namespace {
+
+// Keywords that are never bare column names, so upper-casing them cannot
+// change result column names
+const std::unordered_set<std::string> KEYWORDS = {
+    "SELECT", "FROM", "WHERE", "GROUP", "BY", "ORDER", "HAVING", "LIMIT", "OFFSET",
+    "JOIN", "INNER", "LEFT", "RIGHT", "FULL", "OUTER", "CROSS", "NATURAL", "ON", "USING",
+    "AS", "AND", "OR", "NOT", "IN", "IS", "NULL", "LIKE", "ILIKE", "BETWEEN",
+    "CASE", "WHEN", "THEN", "ELSE", "END", "DISTINCT", "ALL", "UNION", "INTERSECT",
+    "EXCEPT", "WITH", "RECURSIVE", "ASC", "DESC", "EXISTS", "ANY", "SOME",
+    "TRUE", "FALSE", "OVER", "PARTITION", "WINDOW", "QUALIFY", "CAST", "VALUES"
+};
+
+// First keyword of a read-only statement
+const std::unordered_set<std::string> READ_STATEMENTS = {
+    "SELECT", "WITH", "VALUES", "FROM"
+};
+
+// Any of these makes a statement a potential write to the session catalog
+const std::unordered_set<std::string> WRITE_KEYWORDS = {
+    "INSERT", "UPDATE", "DELETE", "CREATE", "DROP", "ALTER", "ATTACH", "DETACH",
+    "COPY", "SET", "RESET", "PRAGMA", "CALL", "INSTALL", "LOAD", "EXPORT", "IMPORT",
+    "USE", "CHECKPOINT", "VACUUM", "TRUNCATE", "MERGE", "BEGIN", "COMMIT", "ROLLBACK"
+};
+
+// Functions whose result differs between runs
+const std::unordered_set<std::string> VOLATILE_FUNCTIONS = {
+    "RANDOM", "SETSEED", "UUID", "GEN_RANDOM_UUID", "NEXTVAL", "CURRVAL",
+    "NOW", "TODAY", "CURRENT_DATE", "CURRENT_TIME", "CURRENT_TIMESTAMP",
+    "GET_CURRENT_TIME", "GET_CURRENT_TIMESTAMP", "TRANSACTION_TIMESTAMP",
+    "CURRENT_LOCALTIME", "CURRENT_LOCALTIMESTAMP"
+};
+
+bool is_word_char(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+bool is_wordish(char c) {
+    return is_word_char(c) || c == '\'' || c == '"';
+}
+
+bool is_tight_punct(char c) {
+    return c == '(' || c == ')' || c == ',';
+}
+
+/**
+ * @brief True if a space between a and b separates tokens that would otherwise merge
+ *
+ * Two words stay apart ("SELECT name"), and so do two operator characters
+ * ("< =" must not become "<="). Around brackets, commas and between a word
+ * and an operator the space carries no meaning.
+ */
+bool needs_space(char a, char b) {
+    if (is_tight_punct(a) || is_tight_punct(b)) return false;
+    return is_wordish(a) == is_wordish(b);
+}
+
+/**
+ * @brief True if only whitespace, semicolons and comments follow position i
+ */
+bool only_trailing(const std::string& sql, size_t i) {
+    const size_t n = sql.size();
+    while (i < n) {
+        char c = sql[i];
+        if (std::isspace(static_cast<unsigned char>(c)) || c == ';') {
+            i++;
+        } else if (c == '-' && i + 1 < n && sql[i + 1] == '-') {
+            while (i < n && sql[i] != '\n') i++;
+        } else if (c == '/' && i + 1 < n && sql[i + 1] == '*') {
+            size_t close = sql.find("*/", i + 2);
+            i = close == std::string::npos ? n : close + 2;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string to_upper(const std::string& s) {
+    std::string upper = s;
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return upper;
+}
+
+uint64_t fnv1a(const std::string& s) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : s) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+NormalizedSQL normalize_sql(const std::string& sql) {
+    NormalizedSQL result;
+    std::string& out = result.text;
+    out.reserve(sql.size());
+
+    std::vector<std::string> words;  // Upper-cased, for classification
+    bool pending_space = false;
+    bool multiple_statements = false;
+
+    // Emit a single separating space before the next token if one is due
+    auto separate = [&](char next) {
+        if (pending_space && !out.empty() && needs_space(out.back(), next)) {
+            out += ' ';
+        }
+        pending_space = false;
+    };
+
+    size_t i = 0;
+    const size_t n = sql.size();
+    while (i < n) {
+        char c = sql[i];
+
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pending_space = true;
+            i++;
+        } else if (c == '-' && i + 1 < n && sql[i + 1] == '-') {
+            while (i < n && sql[i] != '\n') i++;
+            pending_space = true;
+        } else if (c == '/' && i + 1 < n && sql[i + 1] == '*') {
+            size_t close = sql.find("*/", i + 2);
+            i = close == std::string::npos ? n : close + 2;
+            pending_space = true;
+        } else if (c == '\'' || c == '"') {
+            // String literal or quoted identifier, doubled quote escapes
+            separate(c);
+            size_t start = i++;
+            while (i < n) {
+                if (sql[i] == c) {
+                    if (i + 1 < n && sql[i + 1] == c) {
+                        i += 2;
+                        continue;
+                    }
+                    i++;
+                    break;
+                }
+                i++;
+            }
+            out.append(sql, start, i - start);
+        } else if (is_word_char(c)) {
+            separate(c);
+            size_t start = i;
+            while (i < n && is_word_char(sql[i])) i++;
+            std::string word = sql.substr(start, i - start);
+            std::string upper = to_upper(word);
+            out += KEYWORDS.count(upper) ? upper : word;
+            words.push_back(std::move(upper));
+        } else {
+            if (c == ';') {
+                // Only trailing semicolons are allowed in a single statement
+                if (only_trailing(sql, i)) break;
+                multiple_statements = true;
+            }
+            separate(c);
+            out += c;
+            i++;
+        }
+    }
+
+    result.hash = fnv1a(out);
+
+    result.read_only = !multiple_statements && !words.empty() && READ_STATEMENTS.count(words.front());
+    result.deterministic = true;
+    for (const auto& word : words) {
+        if (WRITE_KEYWORDS.count(word)) result.read_only = false;
+        // Other sessions' catalogs (sess_<n>) hold per-session state
+        if (VOLATILE_FUNCTIONS.count(word) || word.rfind("SESS_", 0) == 0) result.deterministic = false;
+    }
+
+    return result;
+}
+
+} // namespace sql_practice
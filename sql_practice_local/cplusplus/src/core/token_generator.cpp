@@ -0,0 +1,56 @@
+#include "include/token_generator.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <sys/random.h>
+
+namespace sql_practice {
+
+namespace {
+
+/**
+ * @brief Per-thread batch of random words
+ */
+struct RandomBatch {
+    static constexpr size_t WORDS = 512;
+
+    uint64_t words[WORDS];
+    size_t next = WORDS;
+
+    void refill() {
+        auto* bytes = reinterpret_cast<unsigned char*>(words);
+        size_t filled = 0;
+        while (filled < sizeof(words)) {
+            ssize_t got = ::getrandom(bytes + filled, sizeof(words) - filled, 0);
+            if (got < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("getrandom failed: ") + std::strerror(errno));
+            }
+            filled += static_cast<size_t>(got);
+        }
+        next = 0;
+    }
+
+    uint64_t take() {
+        if (next == WORDS) refill();
+        uint64_t word = words[next];
+        words[next++] = 0;  // Do not keep handed-out token bits around
+        return word;
+    }
+};
+
+} // namespace
+
+SessionToken TokenGenerator::next() {
+    thread_local RandomBatch batch;
+
+    SessionToken token;
+    while (token.empty()) {
+        token.hi = batch.take();
+        token.lo = batch.take();
+    }
+    return token;
+}
+
+} // namespace sql_practice
@@ -1,52 +1,119 @@
 #include "include/sql_executor.hpp"
+#include "include/instance_pool.hpp"
+#include "include/fixture_catalog.hpp"
+#include "include/config.hpp"
+#include "include/query_watchdog.hpp"
+#include "include/resource_governor.hpp"
 #include <duckdb.hpp>
+#include <nlohmann/json.hpp>
+#include <atomic>
 #include <chrono>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 
 namespace sql_practice {
 
 // =============================================================================
-// TODO: Shared DuckDB Instance Architecture
+// QuestionSchemaLRU Implementation
 // =============================================================================
-// Current Issue: Each session creates its own DuckDB instance (~24MB virtual memory each)
-// With 1000 sessions = 24GB+ virtual memory (though actual RSS is much lower)
-//
-// Proposed Architecture:
-// - Create N shared DuckDB instances (where N = total_sessions / connections_per_instance)
-// - Each session gets a Connection to one of the shared instances
-// - DuckDB can handle many concurrent connections per instance
-//
-// Example calculation:
-// - Target: 10,000 concurrent users
-// - Connections per DuckDB instance: ~100-1000 (DuckDB is quite efficient)
-// - Number of instances needed: 10,000 / 500 = 20 instances
-// - Memory per instance: ~24MB virtual
-// - Total virtual memory: 20 * 24MB = 480MB (vs 240GB for separate instances)
-//
-// Implementation approach:
-// 1. Create a connection pool that manages multiple DuckDB instances
-// 2. Each session gets assigned a connection from the pool
-// 3. Connections are returned to pool when session expires
-// 4. Use round-robin or least-loaded assignment
+
+QuestionSchemaLRU::QuestionSchemaLRU(size_t max_schemas)
+    : capacity(std::max<size_t>(max_schemas, 1)) {
+}
+
+bool QuestionSchemaLRU::touch(const std::string& schema_name) {
+    auto it = index.find(schema_name);
+    if (it == index.end()) return false;
+    order.splice(order.begin(), order, it->second);
+    return true;
+}
+
+std::optional<std::string> QuestionSchemaLRU::insert(const std::string& schema_name) {
+    if (touch(schema_name)) return std::nullopt;
+
+    order.push_front(schema_name);
+    index[schema_name] = order.begin();
+
+    if (order.size() <= capacity) return std::nullopt;
+
+    std::string evicted = order.back();
+    index.erase(evicted);
+    order.pop_back();
+    return evicted;
+}
+
+// =============================================================================
+// ParsedQuery Implementation
 // =============================================================================
 
+struct ParsedQuery::Statements {
+    duckdb::vector<duckdb::unique_ptr<duckdb::SQLStatement>> list;
+};
+
+ParsedQuery::ParsedQuery() = default;
+ParsedQuery::ParsedQuery(ParsedQuery&&) noexcept = default;
+ParsedQuery& ParsedQuery::operator=(ParsedQuery&&) noexcept = default;
+ParsedQuery::~ParsedQuery() = default;
+
+size_t ParsedQuery::statement_count() const {
+    return statements ? statements->list.size() : 0;
+}
+
+bool ParsedQuery::read_only() const {
+    if (!statements) return false;
+    return std::all_of(statements->list.begin(), statements->list.end(), [](const auto& statement) {
+        return statement->type == duckdb::StatementType::SELECT_STATEMENT;
+    });
+}
+
+/**
+ * @brief Text of one statement as the student wrote it
+ *
+ * ExtractStatements leaves the whole submitted string in each statement's
+ * query; stmt_location/stmt_length pick out that statement's part.
+ */
+static std::string statement_sql(const duckdb::SQLStatement& statement) {
+    const auto& query = statement.query;
+    if (statement.stmt_length == 0 || statement.stmt_length == query.size() ||
+        statement.stmt_location + statement.stmt_length > query.size()) {
+        return query;
+    }
+    return query.substr(statement.stmt_location, statement.stmt_length);
+}
+
+std::string ParsedQuery::select_sql() const {
+    if (statement_count() != 1) return std::string();
+
+    const auto& statement = *statements->list.front();
+    if (statement.type != duckdb::StatementType::SELECT_STATEMENT) return std::string();
+
+    return statement_sql(statement);
+}
+
 // =============================================================================
 // DuckDBConnection Implementation
 // =============================================================================
 
-DuckDBConnection::DuckDBConnection(const std::string& path) {
+DuckDBConnection::DuckDBConnection(const std::string& path)
+    : db(nullptr), conn(nullptr), instance_id(0), fixtures_attached(false),
+      question_schemas(Config::question_schema_cache_size) {
     try {
+        duckdb::DBConfig config;
+        apply_resource_limits(config);
+
         // Create DuckDB instance (in-memory if path is ":memory:")
         if (path == ":memory:" || path.empty()) {
             db = nullptr;  // Will use default in-memory
-            auto db_ptr = new duckdb::DuckDB(nullptr);
+            auto db_ptr = new duckdb::DuckDB(nullptr, &config);
             db = static_cast<void*>(db_ptr);
             auto conn_ptr = new duckdb::Connection(*db_ptr);
             conn = static_cast<void*>(conn_ptr);
         } else {
-            auto db_ptr = new duckdb::DuckDB(path);
+            auto db_ptr = new duckdb::DuckDB(path, &config);
             db = static_cast<void*>(db_ptr);
             auto conn_ptr = new duckdb::Connection(*db_ptr);
             conn = static_cast<void*>(conn_ptr);
@@ -57,24 +124,358 @@ DuckDBConnection::DuckDBConnection(const std::string& path) {
     }
 }
 
+DuckDBConnection::DuckDBConnection(std::shared_ptr<DuckDBInstancePool> instance_pool)
+    : db(nullptr), conn(nullptr), pool(std::move(instance_pool)), instance_id(0),
+      fixtures_attached(false), question_schemas(Config::question_schema_cache_size) {
+    // Catalog names only need to be unique per process
+    static std::atomic<uint64_t> next_catalog_id{0};
+
+    auto lease = pool->acquire();
+    instance_id = lease.instance_id;
+    fixtures_attached = lease.has_fixtures;
+
+    try {
+        auto conn_ptr = new duckdb::Connection(*lease.database);
+        conn = static_cast<void*>(conn_ptr);
+
+        // Give the session its own in-memory catalog on the shared instance
+        std::string name = "sess_" + std::to_string(next_catalog_id.fetch_add(1));
+        auto attach_result = conn_ptr->Query("ATTACH ':memory:' AS " + name);
+        if (attach_result->HasError()) {
+            throw std::runtime_error(attach_result->GetError());
+        }
+        catalog_name = name;
+
+        auto use_result = conn_ptr->Query("USE " + catalog_name);
+        if (use_result->HasError()) {
+            throw std::runtime_error(use_result->GetError());
+        }
+    } catch (const std::exception& e) {
+        if (conn) {
+            auto* conn_ptr = static_cast<duckdb::Connection*>(conn);
+            if (!catalog_name.empty()) {
+                conn_ptr->Query("DETACH " + catalog_name);
+                catalog_name.clear();
+            }
+            delete conn_ptr;
+            conn = nullptr;
+        }
+        pool->release(instance_id);
+        pool.reset();
+        throw;
+    }
+}
+
 DuckDBConnection::~DuckDBConnection() {
     if (conn) {
-        delete static_cast<duckdb::Connection*>(conn);
+        auto* conn_ptr = static_cast<duckdb::Connection*>(conn);
+        auto database = conn_ptr->context->db;
+        delete conn_ptr;
         conn = nullptr;
+        if (!catalog_name.empty()) {
+            // Drop the session catalog so the shared instance frees its memory.
+            // A connection cannot detach the catalog it is using, and the
+            // instance has no default catalog to switch to, so use a new one.
+            try {
+                duckdb::Connection(*database).Query("DETACH " + catalog_name);
+            } catch (const std::exception& e) {
+                // Nothing useful to do during teardown
+            }
+        }
     }
     if (db) {
         delete static_cast<duckdb::DuckDB*>(db);
         db = nullptr;
     }
+    if (pool) {
+        pool->release(instance_id);
+    }
+}
+
+/**
+ * @brief Storage class used for a DuckDB result column
+ *
+ * UBIGINT, HUGEINT and DECIMAL may not fit an int64/double exactly and are
+ * kept as text along with every non-numeric type.
+ */
+static ColumnKind column_kind_for(const duckdb::LogicalType& type) {
+    switch (type.id()) {
+        case duckdb::LogicalTypeId::BOOLEAN:
+            return ColumnKind::BOOLEAN;
+        case duckdb::LogicalTypeId::TINYINT:
+        case duckdb::LogicalTypeId::SMALLINT:
+        case duckdb::LogicalTypeId::INTEGER:
+        case duckdb::LogicalTypeId::BIGINT:
+        case duckdb::LogicalTypeId::UTINYINT:
+        case duckdb::LogicalTypeId::USMALLINT:
+        case duckdb::LogicalTypeId::UINTEGER:
+            return ColumnKind::INTEGER;
+        case duckdb::LogicalTypeId::FLOAT:
+        case duckdb::LogicalTypeId::DOUBLE:
+            return ColumnKind::DOUBLE;
+        default:
+            return ColumnKind::TEXT;
+    }
+}
+
+/**
+ * @brief Append one DuckDB value to a result column of matching kind
+ */
+static void append_result_value(ResultColumn& column, const duckdb::Value& value) {
+    if (value.IsNull()) {
+        column.append_null();
+        return;
+    }
+    switch (column.kind) {
+        case ColumnKind::BOOLEAN: column.append_int(value.GetValue<bool>() ? 1 : 0); break;
+        case ColumnKind::INTEGER: column.append_int(value.GetValue<int64_t>()); break;
+        case ColumnKind::DOUBLE: column.append_double(value.GetValue<double>()); break;
+        case ColumnKind::TEXT: column.append_text(value.ToString()); break;
+    }
+}
+
+/**
+ * @brief Append the first count rows of a numeric vector
+ *
+ * row_bytes[i] grows by 8 for each value and 4 for each NULL.
+ */
+template <typename T>
+static void append_numeric_vector(ResultColumn& column, duckdb::Vector& vector, size_t count,
+                                  std::vector<size_t>& row_bytes) {
+    duckdb::UnifiedVectorFormat format;
+    vector.ToUnifiedFormat(count, format);
+    auto values = duckdb::UnifiedVectorFormat::GetData<T>(format);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto idx = format.sel->get_index(i);
+        if (!format.validity.RowIsValid(idx)) {
+            column.append_null();
+            row_bytes[i] += 4;
+            continue;
+        }
+        if constexpr (std::is_floating_point<T>::value) {
+            column.append_double(static_cast<double>(values[idx]));
+        } else {
+            column.append_int(static_cast<int64_t>(values[idx]));
+        }
+        row_bytes[i] += 8;
+    }
+}
+
+/**
+ * @brief Append the first count rows of a VARCHAR vector, copying from string_t
+ */
+static void append_string_vector(ResultColumn& column, duckdb::Vector& vector, size_t count,
+                                 std::vector<size_t>& row_bytes) {
+    duckdb::UnifiedVectorFormat format;
+    vector.ToUnifiedFormat(count, format);
+    auto values = duckdb::UnifiedVectorFormat::GetData<duckdb::string_t>(format);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto idx = format.sel->get_index(i);
+        if (!format.validity.RowIsValid(idx)) {
+            column.append_null();
+            row_bytes[i] += 4;
+            continue;
+        }
+        const auto& value = values[idx];
+        column.append_text(std::string(value.GetData(), value.GetSize()));
+        row_bytes[i] += value.GetSize();
+    }
+}
+
+/**
+ * @brief Append the first count rows of one chunk column
+ *
+ * Reads the vector once through its unified format instead of boxing every
+ * cell in a duckdb::Value. Text columns of non-VARCHAR types (DATE,
+ * DECIMAL, ...) are cast to VARCHAR a whole vector at a time; if that cast
+ * fails the column falls back to Value::ToString per cell.
+ */
+static void append_chunk_column(ResultColumn& column, duckdb::Vector& vector, size_t count,
+                                duckdb::ClientContext& context, std::vector<size_t>& row_bytes) {
+    switch (vector.GetType().id()) {
+        case duckdb::LogicalTypeId::BOOLEAN: return append_numeric_vector<bool>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::TINYINT: return append_numeric_vector<int8_t>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::SMALLINT: return append_numeric_vector<int16_t>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::INTEGER: return append_numeric_vector<int32_t>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::BIGINT: return append_numeric_vector<int64_t>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::UTINYINT: return append_numeric_vector<uint8_t>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::USMALLINT: return append_numeric_vector<uint16_t>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::UINTEGER: return append_numeric_vector<uint32_t>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::FLOAT: return append_numeric_vector<float>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::DOUBLE: return append_numeric_vector<double>(column, vector, count, row_bytes);
+        case duckdb::LogicalTypeId::VARCHAR: return append_string_vector(column, vector, count, row_bytes);
+        default: break;
+    }
+
+    size_t start = column.size();
+    try {
+        duckdb::Vector text(duckdb::LogicalType::VARCHAR, count);
+        duckdb::VectorOperations::Cast(context, vector, text, count);
+        append_string_vector(column, text, count, row_bytes);
+    } catch (const std::exception&) {
+        column.truncate(start);
+        for (size_t i = 0; i < count; ++i) {
+            auto value = vector.GetValue(i);
+            append_result_value(column, value);
+            row_bytes[i] += value.IsNull() ? 4 : column.strings.back().size();
+        }
+    }
+}
+
+void append_chunk_rows(QueryResult& result, duckdb::DataChunk& chunk, size_t count,
+                       duckdb::ClientContext& context) {
+    if (result.data.empty()) {
+        result.data.reserve(chunk.ColumnCount());
+        for (size_t col = 0; col < chunk.ColumnCount(); ++col) {
+            result.data.emplace_back(column_kind_for(chunk.data[col].GetType()));
+        }
+    }
+
+    std::vector<size_t> row_bytes(count, 0);
+    for (size_t col = 0; col < result.data.size(); ++col) {
+        append_chunk_column(result.data[col], chunk.data[col], count, context, row_bytes);
+    }
+    result.row_count += static_cast<int>(count);
+}
+
+QueryResult DuckDBConnection::execute(
+    const std::string& sql,
+    const ResultLimits& limits,
+    ResultChunkSink* sink,
+    bool materialize
+) {
+    auto* conn_ptr = static_cast<duckdb::Connection*>(conn);
+    return run_guarded([&]() { return conn_ptr->SendQuery(sql); }, limits, sink, materialize);
+}
+
+ParsedQuery DuckDBConnection::parse(const std::string& sql) {
+    ParsedQuery parsed;
+    if (!conn) {
+        parsed.error_message = "Database connection unavailable";
+        return parsed;
+    }
+
+    try {
+        parsed.statements = std::make_unique<ParsedQuery::Statements>();
+        parsed.statements->list = static_cast<duckdb::Connection*>(conn)->ExtractStatements(sql);
+    } catch (const std::exception& e) {
+        duckdb::ErrorData error(e);
+        parsed.statements.reset();
+        parsed.error_message = error.Message();
+    }
+    return parsed;
+}
+
+QueryResult DuckDBConnection::execute(
+    ParsedQuery&& query,
+    const ResultLimits& limits,
+    ResultChunkSink* sink,
+    bool materialize,
+    const std::function<void(QueryResult&)>& on_success
+) {
+    auto* conn_ptr = static_cast<duckdb::Connection*>(conn);
+
+    // Anything beyond SELECT runs in a transaction that is rolled back afterwards
+    bool isolate = false;
+    if (conn_ptr && query.statement_count() > 0) {
+        for (const auto& statement : query.statements->list) {
+            if (statement->type != duckdb::StatementType::SELECT_STATEMENT) isolate = true;
+        }
+    }
+    if (isolate) {
+        try {
+            conn_ptr->BeginTransaction();
+        } catch (const std::exception&) {
+            isolate = false;
+        }
+    }
+
+    QueryResult result = run_guarded([&]() -> std::unique_ptr<duckdb::QueryResult> {
+        if (query.statement_count() == 0) {
+            throw std::runtime_error("No statement to execute");
+        }
+        auto& statements = query.statements->list;
+
+        // Leading statements (e.g. CREATE MACRO before the SELECT) run to completion
+        for (size_t i = 0; i + 1 < statements.size(); ++i) {
+            auto leading = conn_ptr->Query(std::move(statements[i]));
+            if (leading->HasError()) {
+                throw std::runtime_error(leading->GetError());
+            }
+        }
+
+        // The last statement streams exactly like SendQuery
+        auto pending = conn_ptr->PendingQuery(std::move(statements.back()), true);
+        if (pending->HasError()) {
+            throw std::runtime_error(pending->GetError());
+        }
+        return pending->Execute();
+    }, limits, sink, materialize);
+
+    if (result.success && on_success) {
+        on_success(result);
+    }
+
+    if (isolate) {
+        try {
+            if (conn_ptr->HasActiveTransaction()) conn_ptr->Rollback();
+        } catch (const std::exception&) {
+        }
+    }
+    return result;
+}
+
+QueryResult DuckDBConnection::run_guarded(
+    const std::function<std::unique_ptr<duckdb::QueryResult>()>& start_query,
+    const ResultLimits& limits,
+    ResultChunkSink* sink,
+    bool materialize
+) {
+    if (!conn || limits.timeout_ms <= 0) {
+        return stream_query(start_query, limits, sink, materialize);
+    }
+
+    auto& watchdog = QueryWatchdog::shared();
+    uint64_t watch = watchdog.arm(static_cast<duckdb::Connection*>(conn), limits.timeout_ms);
+    QueryResult result = stream_query(start_query, limits, sink, materialize);
+
+    // Whatever the query returned, an interrupt from the watchdog means it ran out of time
+    if (watchdog.disarm(watch)) {
+        auto elapsed = result.execution_time_ms;
+        result = QueryResult();
+        result.timed_out = true;
+        result.execution_time_ms = elapsed;
+        result.error_message = "Query exceeded the time limit of " +
+                               std::to_string(limits.timeout_ms) + " ms";
+    }
+    return result;
 }
 
-QueryResult DuckDBConnection::execute(const std::string& sql) {
+QueryResult DuckDBConnection::stream_query(
+    const std::function<std::unique_ptr<duckdb::QueryResult>()>& start_query,
+    const ResultLimits& limits,
+    ResultChunkSink* sink,
+    bool materialize
+) {
     QueryResult result;
     auto start = std::chrono::high_resolution_clock::now();
 
+    if (!conn) {
+        result.success = false;
+        result.error_message = "Database connection unavailable";
+        return result;
+    }
+
     try {
         auto* conn_ptr = static_cast<duckdb::Connection*>(conn);
-        auto query_result = conn_ptr->Query(sql);
+
+        // Stream the result so rows beyond the limits are never produced
+        auto query_result = start_query();
+        auto started = std::chrono::high_resolution_clock::now();
+        result.execute_us = std::chrono::duration_cast<std::chrono::microseconds>(started - start).count();
+        std::chrono::high_resolution_clock::duration sink_time{0};
 
         // Check for errors
         if (query_result->HasError()) {
@@ -88,40 +489,95 @@ QueryResult DuckDBConnection::execute(const std::string& sql) {
 
         result.success = true;
 
-        // Get column names
-        if (query_result->RowCount() > 0) {
-            auto columns = query_result->ColumnCount();
-            for (size_t i = 0; i < columns; ++i) {
-                result.columns.push_back(query_result->ColumnName(i));
+        // Get column names and pick a storage class per column
+        auto columns = query_result->ColumnCount();
+        result.data.reserve(columns);
+        for (size_t i = 0; i < columns; ++i) {
+            result.columns.push_back(query_result->ColumnName(i));
+            if (materialize) {
+                result.data.emplace_back(column_kind_for(query_result->types[i]));
             }
+        }
+        if (sink) {
+            auto sink_start = std::chrono::high_resolution_clock::now();
+            sink->begin(result.columns);
+            sink_time += std::chrono::high_resolution_clock::now() - sink_start;
+        }
+
+        // Get rows - pull chunks with Fetch() until done or a limit is hit
+        size_t row_count = 0;
+        size_t byte_count = 0;
+        bool limit_reached = false;
+        std::vector<size_t> row_bytes;
+        while (!limit_reached) {
+            auto chunk = query_result->Fetch();
+            if (!chunk || chunk->size() == 0) break;
 
-            // Get rows - iterate through chunks using Fetch()
-            size_t row_count = 0;
-            while (true) {
-                auto chunk = query_result->Fetch();
-                if (!chunk || chunk->size() == 0) break;
-
-                for (size_t row_idx = 0; row_idx < chunk->size(); ++row_idx) {
-                    std::unordered_map<std::string, std::string> row_data;
-                    for (size_t col_idx = 0; col_idx < columns; ++col_idx) {
-                        std::string value_str;
-                        auto value = chunk->GetValue(col_idx, row_idx);
-                        if (value.IsNull()) {
-                            value_str = "NULL";
-                        } else {
-                            value_str = value.ToString();
-                        }
-                        row_data[result.columns[col_idx]] = value_str;
+            if (limits.max_rows > 0 && row_count >= limits.max_rows) {
+                limit_reached = true;
+                break;
+            }
+
+            size_t take = chunk->size();
+            if (limits.max_rows > 0 && row_count + take > limits.max_rows) {
+                take = limits.max_rows - row_count;
+                limit_reached = true;
+            }
+
+            // Convert column by column, tracking the text size of each row
+            row_bytes.assign(take, 0);
+            for (size_t col_idx = 0; col_idx < result.data.size(); ++col_idx) {
+                auto& column = result.data[col_idx];
+                column.reserve(row_count + take);
+                append_chunk_column(column, chunk->data[col_idx], take, *conn_ptr->context, row_bytes);
+            }
+
+            // Keep the rows that fit in the byte budget
+            size_t keep = take;
+            if (sink) {
+                auto sink_start = std::chrono::high_resolution_clock::now();
+                keep = sink->append(*chunk, take, *conn_ptr->context);
+                sink_time += std::chrono::high_resolution_clock::now() - sink_start;
+                if (keep < take) limit_reached = true;
+            } else if (limits.max_bytes > 0) {
+                for (size_t i = 0; i < take; ++i) {
+                    if (byte_count + row_bytes[i] > limits.max_bytes) {
+                        keep = i;
+                        limit_reached = true;
+                        break;
                     }
-                    result.rows.push_back(row_data);
-                    row_count++;
+                    byte_count += row_bytes[i];
                 }
             }
-            result.row_count = static_cast<int>(row_count);
+            if (keep < take) {
+                for (auto& column : result.data) {
+                    column.truncate(row_count + keep);
+                }
+            }
+
+            row_count += keep;
         }
 
+        // A streaming query can fail after the first chunk
+        if (query_result->HasError()) {
+            result = QueryResult();
+            result.error_message = query_result->GetError();
+            result.execution_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - start
+            ).count();
+            return result;
+        }
+
+        result.row_count = static_cast<int>(row_count);
+        result.truncated = limit_reached;
+
+        auto finished = std::chrono::high_resolution_clock::now();
+        result.sink_us = std::chrono::duration_cast<std::chrono::microseconds>(sink_time).count();
+        result.fetch_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            finished - started - sink_time
+        ).count();
         result.execution_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::high_resolution_clock::now() - start
+            finished - start
         ).count();
 
     } catch (const std::exception& e) {
@@ -143,21 +599,63 @@ SQLExecutor::SQLExecutor(const std::string& db_path)
     : shared_db_path(db_path) {
 }
 
+SQLExecutor::SQLExecutor(std::shared_ptr<DuckDBInstancePool> pool)
+    : shared_db_path(":memory:"), instance_pool(std::move(pool)) {
+}
+
 std::unique_ptr<DuckDBConnection> SQLExecutor::create_connection() {
+    if (instance_pool) {
+        return std::make_unique<DuckDBConnection>(instance_pool);
+    }
     return std::make_unique<DuckDBConnection>(":memory:");
 }
 
+/**
+ * @brief Append one fixture cell using the column's declared type
+ *
+ * Numeric columns are parsed once here; everything else is appended as text
+ * and cast by the Appender (VARCHAR, DATE, ...).
+ */
+static void append_fixture_value(
+    duckdb::Appender& appender,
+    const std::string& type,
+    const std::string* value
+) {
+    if (!value || *value == "NULL") {
+        appender.Append(nullptr);
+        return;
+    }
+
+    std::string upper_type = type;
+    std::transform(upper_type.begin(), upper_type.end(), upper_type.begin(), ::toupper);
+
+    if (upper_type == "INTEGER" || upper_type == "BIGINT" ||
+        upper_type == "SMALLINT" || upper_type == "TINYINT" || upper_type == "INT") {
+        appender.Append<int64_t>(std::stoll(*value));
+    } else if (upper_type == "FLOAT" || upper_type == "DOUBLE" || upper_type == "REAL") {
+        appender.Append<double>(std::stod(*value));
+    } else if (upper_type == "BOOLEAN" || upper_type == "BOOL") {
+        appender.Append<bool>(*value == "true" || *value == "TRUE" || *value == "1");
+    } else {
+        appender.Append(value->c_str(), static_cast<uint32_t>(value->size()));
+    }
+}
+
 bool SQLExecutor::initialize_schema(
     DuckDBConnection* conn,
-    const QuestionSchema& schema
+    const QuestionSchema& schema,
+    const std::string& schema_name
 ) {
-    if (!conn) return false;
+    if (!conn || !conn->get_connection()) return false;
+
+    auto* conn_ptr = static_cast<duckdb::Connection*>(conn->get_connection());
+    std::string prefix = schema_name.empty() ? "" : "\"" + schema_name + "\".";
 
     try {
-        // Create tables
         for (const auto& table : schema.tables) {
+            // Create table
             std::stringstream sql;
-            sql << "CREATE TABLE " << table.name << " (";
+            sql << "CREATE TABLE " << prefix << table.name << " (";
 
             for (size_t i = 0; i < table.columns.size(); ++i) {
                 const auto& col = table.columns[i];
@@ -168,50 +666,34 @@ bool SQLExecutor::initialize_schema(
             }
             sql << ");";
 
-            auto result = conn->execute(sql.str());
-            if (!result.success) {
+            auto result = conn_ptr->Query(sql.str());
+            if (result->HasError()) {
                 return false;
             }
 
-            // Insert sample data
+            // Bulk-load sample data through one Appender per table
             auto it = schema.sample_data.find(table.name);
-            if (it != schema.sample_data.end()) {
-                for (const auto& row : it->second) {
-                    std::stringstream insert_sql;
-                    insert_sql << "INSERT INTO " << table.name << " VALUES (";
-
-                    for (size_t i = 0; i < table.columns.size(); ++i) {
-                        const auto& col = table.columns[i];
-                        auto row_it = row.find(col.name);
-
-                        if (row_it == row.end() || row_it->second == "NULL") {
-                            insert_sql << "NULL";
-                        } else if (col.type == "INTEGER" || col.type == "FLOAT") {
-                            insert_sql << row_it->second;
-                        } else {
-                            // Escape string values
-                            std::string value = row_it->second;
-                            // Simple escape for single quotes
-                            size_t pos = 0;
-                            while ((pos = value.find("'", pos)) != std::string::npos) {
-                                value.replace(pos, 1, "''");
-                                pos += 2;
-                            }
-                            insert_sql << "'" << value << "'";
-                        }
-
-                        if (i < table.columns.size() - 1) {
-                            insert_sql << ", ";
-                        }
-                    }
-                    insert_sql << ");";
+            if (it == schema.sample_data.end() || it->second.empty()) {
+                continue;
+            }
 
-                    auto insert_result = conn->execute(insert_sql.str());
-                    if (!insert_result.success) {
-                        return false;
-                    }
+            std::unique_ptr<duckdb::Appender> appender;
+            if (schema_name.empty()) {
+                appender = std::make_unique<duckdb::Appender>(*conn_ptr, table.name);
+            } else {
+                appender = std::make_unique<duckdb::Appender>(*conn_ptr, schema_name, table.name);
+            }
+
+            for (const auto& row : it->second) {
+                appender->BeginRow();
+                for (const auto& col : table.columns) {
+                    auto row_it = row.find(col.name);
+                    append_fixture_value(*appender, col.type,
+                                         row_it == row.end() ? nullptr : &row_it->second);
                 }
+                appender->EndRow();
             }
+            appender->Close();
         }
 
         return true;
@@ -221,6 +703,84 @@ bool SQLExecutor::initialize_schema(
     }
 }
 
+bool SQLExecutor::load_question_fixture(
+    DuckDBConnection* conn,
+    const std::string& question_id,
+    const QuestionSchema& schema,
+    bool writable
+) {
+    if (!conn) return false;
+
+    std::string schema_name = FixtureCatalog::schema_for(question_id);
+    std::string qualified = conn->get_catalog_name().empty()
+        ? "\"" + schema_name + "\""
+        : "\"" + conn->get_catalog_name() + "\".\"" + schema_name + "\"";
+
+    auto& loaded = conn->get_question_schemas();
+    if (!loaded.touch(schema_name)) {
+        auto create_result = conn->execute("CREATE SCHEMA IF NOT EXISTS " + qualified);
+        if (!create_result.success) return false;
+
+        bool ready = false;
+        if (conn->has_fixture_catalog() && !writable) {
+            // Views cost a catalog entry each; the data stays in the shared file
+            std::string fixture_schema = std::string(FixtureCatalog::CATALOG_NAME) + ".\"" +
+                                         schema_name + "\"";
+            ready = true;
+            for (const auto& table : schema.tables) {
+                auto result = conn->execute(
+                    "CREATE OR REPLACE VIEW " + qualified + "." + table.name +
+                    " AS SELECT * FROM " + fixture_schema + "." + table.name
+                );
+                if (!result.success) {
+                    ready = false;
+                    break;
+                }
+            }
+        }
+
+        if (!ready) {
+            // Question missing from the fixture catalog (or no catalog): private copy
+            conn->execute("DROP SCHEMA IF EXISTS " + qualified + " CASCADE");
+            conn->execute("CREATE SCHEMA " + qualified);
+            ready = initialize_schema(conn, schema, schema_name);
+        }
+
+        if (!ready) {
+            conn->execute("DROP SCHEMA IF EXISTS " + qualified + " CASCADE");
+            return false;
+        }
+
+        if (auto evicted = loaded.insert(schema_name)) {
+            std::string evicted_qualified = conn->get_catalog_name().empty()
+                ? "\"" + *evicted + "\""
+                : "\"" + conn->get_catalog_name() + "\".\"" + *evicted + "\"";
+            conn->execute("DROP SCHEMA IF EXISTS " + evicted_qualified + " CASCADE");
+        }
+    }
+
+    auto switch_result = conn->execute("SET search_path = '" + qualified + "'");
+    return switch_result.success;
+}
+
+bool SQLExecutor::modifies_tables(const std::vector<std::string>& allowed_statements) {
+    static const char* const writes[] = {"INSERT", "UPDATE", "DELETE", "MERGE", "ALTER", "DROP"};
+    for (const auto& statement : allowed_statements) {
+        for (const char* write : writes) {
+            if (statement == write) return true;
+        }
+    }
+    return false;
+}
+
+ResultLimits SQLExecutor::limits_for(const std::string& difficulty) {
+    ResultLimits limits;
+    limits.max_rows = static_cast<size_t>(std::max(Config::max_result_rows, 0));
+    limits.max_bytes = static_cast<size_t>(std::max<int64_t>(Config::max_result_bytes, 0));
+    limits.timeout_ms = std::max(Config::query_timeout_for(difficulty), 0);
+    return limits;
+}
+
 QueryResult SQLExecutor::execute(
     DuckDBConnection* conn,
     const std::string& sql
@@ -232,69 +792,361 @@ QueryResult SQLExecutor::execute(
         return result;
     }
 
-    return conn->execute(sql);
+    return conn->execute(sql, limits_for());
 }
 
-bool SQLExecutor::compare_results(
-    const QueryResult& result,
-    const std::vector<std::unordered_map<std::string, std::string>>& expected
-) const {
-    // Compare columns
-    if (result.columns.size() != expected.empty() ? 0 : expected[0].size()) {
-        return false;
+QueryResult SQLExecutor::execute(
+    DuckDBConnection* conn,
+    const std::string& sql,
+    const ResultLimits& limits,
+    ResultChunkSink* sink,
+    bool materialize
+) {
+    if (!conn) {
+        QueryResult result;
+        result.success = false;
+        result.error_message = "Invalid database connection";
+        return result;
     }
 
-    // Compare row count
-    if (result.rows.size() != expected.size()) {
-        return false;
+    return conn->execute(sql, limits, sink, materialize);
+}
+
+QueryResult SQLExecutor::execute(
+    DuckDBConnection* conn,
+    ParsedQuery&& query,
+    const ResultLimits& limits,
+    ResultChunkSink* sink,
+    bool materialize
+) {
+    if (!conn) {
+        QueryResult result;
+        result.success = false;
+        result.error_message = "Invalid database connection";
+        return result;
     }
 
-    // Compare data
-    for (size_t i = 0; i < result.rows.size(); ++i) {
-        const auto& result_row = result.rows[i];
-        const auto& expected_row = expected[i];
+    return conn->execute(std::move(query), limits, sink, materialize);
+}
 
-        for (const auto& col : result.columns) {
-            auto result_val = result_row.find(col);
-            auto expected_val = expected_row.find(col);
+QueryResult SQLExecutor::explain_analyze(
+    DuckDBConnection* conn,
+    ParsedQuery&& query,
+    const ResultLimits& limits,
+    std::string& profile_json
+) {
+    if (!conn || !conn->get_connection()) {
+        QueryResult result;
+        result.success = false;
+        result.error_message = "Invalid database connection";
+        return result;
+    }
 
-            if (result_val == result_row.end() || expected_val == expected_row.end()) {
-                return false;
+    // Profile without printing it; the JSON is read back from the connection
+    auto enable = conn->execute("SET enable_profiling = 'no_output'");
+    if (!enable.success) return enable;
+
+    // Read inside execute: a data-changing statement is rolled back after
+    // it, and the ROLLBACK's own profile would replace the statement's
+    ResultLimits profile_limits;
+    profile_limits.timeout_ms = limits.timeout_ms;
+    auto result = conn->execute(std::move(query), profile_limits, nullptr, false, [&](QueryResult& ran) {
+        try {
+            auto* conn_ptr = static_cast<duckdb::Connection*>(conn->get_connection());
+            profile_json = conn_ptr->GetProfilingInformation(duckdb::ProfilerPrintFormat::JSON);
+        } catch (const std::exception& e) {
+            ran.success = false;
+            ran.error_message = e.what();
+        }
+    });
+
+    conn->execute("RESET enable_profiling");
+    return result;
+}
+
+/**
+ * @brief Allow-list name of a parsed statement type
+ *
+ * Matches the leading keyword students write; types without a common
+ * keyword fall back to DuckDB's own name.
+ */
+static std::string statement_type_name(duckdb::StatementType type) {
+    switch (type) {
+        case duckdb::StatementType::SELECT_STATEMENT: return "SELECT";
+        case duckdb::StatementType::INSERT_STATEMENT: return "INSERT";
+        case duckdb::StatementType::UPDATE_STATEMENT: return "UPDATE";
+        case duckdb::StatementType::DELETE_STATEMENT: return "DELETE";
+        case duckdb::StatementType::MERGE_INTO_STATEMENT: return "MERGE";
+        case duckdb::StatementType::CREATE_STATEMENT:
+        case duckdb::StatementType::CREATE_FUNC_STATEMENT: return "CREATE";
+        case duckdb::StatementType::DROP_STATEMENT: return "DROP";
+        case duckdb::StatementType::ALTER_STATEMENT: return "ALTER";
+        case duckdb::StatementType::EXPLAIN_STATEMENT: return "EXPLAIN";
+        case duckdb::StatementType::TRANSACTION_STATEMENT: return "TRANSACTION";
+        case duckdb::StatementType::PREPARE_STATEMENT: return "PREPARE";
+        case duckdb::StatementType::EXECUTE_STATEMENT: return "EXECUTE";
+        case duckdb::StatementType::COPY_STATEMENT: return "COPY";
+        case duckdb::StatementType::ATTACH_STATEMENT: return "ATTACH";
+        case duckdb::StatementType::DETACH_STATEMENT: return "DETACH";
+        default: return duckdb::StatementTypeToString(type);
+    }
+}
+
+/**
+ * @brief Textual check of a statement check_references cannot inspect
+ *
+ * Used for statements DuckDB will not serialize (anything but a SELECT,
+ * which only write-enabled questions allow, and a few SELECT forms such
+ * as PIVOT). It refuses the same things as check_references, but runs
+ * over every word of the SQL text, including quoted identifiers, string
+ * literals and comments, so it can only over-reject: any sess_<n> or
+ * fixtures word, words starting with "__", the metadata functions and
+ * views, SHOW ALL TABLES, SHOW DATABASES, a bare DESCRIBE, and query() /
+ * query_table(), which bind SQL assembled at run time.
+ *
+ * @return Error message, or empty when the SQL is acceptable
+ */
+static std::string check_reserved_names(const std::string& sql) {
+    auto is_word_char = [](unsigned char c) { return std::isalnum(c) || c == '_' || c == '$'; };
+    static const char* const metadata_views[] = {
+        "information_schema", "pg_catalog", "sqlite_master", "sqlite_schema", "sqlite_temp_master"
+    };
+
+    size_t i = 0;
+    bool after_show = false;  // Previous word was SHOW
+    while (i < sql.size()) {
+        if (!is_word_char(static_cast<unsigned char>(sql[i]))) {
+            ++i;
+            continue;
+        }
+        size_t start = i;
+        while (i < sql.size() && is_word_char(static_cast<unsigned char>(sql[i]))) ++i;
+        std::string word = sql.substr(start, i - start);
+        std::transform(word.begin(), word.end(), word.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        if (word.size() > 5 && word.compare(0, 5, "sess_") == 0 &&
+            std::all_of(word.begin() + 5, word.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            return "Queries may not reference session catalogs";
+        }
+        if (word == FixtureCatalog::CATALOG_NAME) {
+            return "Queries may not reference the fixtures catalog directly";
+        }
+        if (word.compare(0, 2, "__") == 0) {
+            return "Names starting with \"__\" are reserved";
+        }
+        if (word.compare(0, 7, "duckdb_") == 0 || word.compare(0, 7, "pragma_") == 0 ||
+            std::find(std::begin(metadata_views), std::end(metadata_views), word) != std::end(metadata_views)) {
+            return "Queries may not read catalog metadata (" + word + ")";
+        }
+        if (after_show && (word == "all" || word == "databases")) {
+            return "Queries may not read catalog metadata (SHOW " + word + ")";
+        }
+        after_show = word == "show";
+
+        // A bare DESCRIBE or SHOW lists every table of every attached database
+        if (word == "describe" || word == "show") {
+            size_t next = i;
+            while (next < sql.size() && std::isspace(static_cast<unsigned char>(sql[next]))) ++next;
+            if (next == sql.size() || sql[next] == ';') {
+                return "Queries may not read catalog metadata (" + word + ")";
             }
+        }
 
-            if (result_val->second != expected_val->second) {
-                return false;
+        if (word == "query" || word == "query_table") {
+            size_t next = i;
+            while (next < sql.size() && std::isspace(static_cast<unsigned char>(sql[next]))) ++next;
+            if (next < sql.size() && sql[next] == '(') {
+                return "The " + word + "() function is not allowed";
             }
         }
     }
+    return "";
+}
 
-    return true;
+static std::string to_lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
 }
 
-bool SQLExecutor::is_safe_query(const std::string& sql) const {
-    // Convert to uppercase for checking
-    std::string upper_sql = sql;
-    std::transform(upper_sql.begin(), upper_sql.end(), upper_sql.begin(), ::toupper);
+/**
+ * @brief True if name (lower case) can be a database attached to an instance
+ *
+ * A pooled instance holds the session catalogs, the fixture catalog and
+ * the server's own "__" catalogs next to DuckDB's system and temp.
+ */
+static bool is_database_name(const std::string& name) {
+    if (name == "memory" || name == "system" || name == "temp" || name == FixtureCatalog::CATALOG_NAME) return true;
+    if (name.compare(0, 2, "__") == 0) return true;
+    return name.size() > 5 && name.compare(0, 5, "sess_") == 0 &&
+           std::all_of(name.begin() + 5, name.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+/**
+ * @brief Check the catalog a table or function reference names
+ *
+ * The parser cannot tell catalog.table from schema.table, so a schema
+ * spelled like an attached database is taken as that database, as the
+ * binder would.
+ */
+static std::string check_catalog(const std::string& catalog, const std::string& schema,
+                                 const std::string& own_catalog) {
+    std::string name = to_lower(catalog);
+    if (name.empty() && is_database_name(to_lower(schema))) name = to_lower(schema);
+    if (name.empty() || name == own_catalog || name == FixtureCatalog::CATALOG_NAME) return "";
+    if (name.size() > 5 && name.compare(0, 5, "sess_") == 0) return "Queries may not reference session catalogs";
+    return "Queries may not reference the " + name + " catalog";
+}
 
-    // Blocked keywords
-    const std::vector<std::string> blocked_keywords = {
-        "DROP", "DELETE", "UPDATE", "INSERT",
-        "ALTER", "TRUNCATE", "CREATE", "GRANT",
-        "REVOKE", "COPY", "EXECUTE"
+/**
+ * @brief Check the table and function references of a serialized SELECT
+ *
+ * Walks the json_serialize_sql tree of one statement, subqueries and CTEs
+ * included. Only the session's own catalog and the read-only fixture
+ * catalog may be named: every session's catalog (sess_<n>) lives on the
+ * same DuckDB instance, so any other would reach state another session
+ * can see. Names starting with "__" are kept for the server's own
+ * objects. Catalog metadata spans every attached database, so DuckDB's
+ * metadata functions (duckdb_tables(), pragma_*), its metadata views
+ * (information_schema, pg_catalog, sqlite_master and the like), SHOW ALL
+ * TABLES, SHOW DATABASES and a bare DESCRIBE are refused. So are query()
+ * and query_table(), which bind SQL assembled at run time.
+ *
+ * @return Error message, or empty when the statement is acceptable
+ */
+static std::string check_references(const nlohmann::json& node, const std::string& own_catalog) {
+    if (node.is_array()) {
+        for (const auto& child : node) {
+            std::string error = check_references(child, own_catalog);
+            if (!error.empty()) return error;
+        }
+        return "";
+    }
+    if (!node.is_object()) return "";
+
+    auto field = [&node](const char* key) {
+        auto it = node.find(key);
+        return it != node.end() && it->is_string() ? it->get<std::string>() : std::string();
+    };
+    auto starts_with = [](const std::string& name, const char* prefix) {
+        return name.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
     };
 
-    for (const auto& keyword : blocked_keywords) {
-        if (upper_sql.find(keyword) != std::string::npos) {
-            return false;
+    std::string type = field("type");
+    if (type == "BASE_TABLE" || type == "SHOW_REF") {
+        std::string table = to_lower(field("table_name"));
+        if (table.size() >= 2 && table.front() == '"' && table.back() == '"') {
+            table = table.substr(1, table.size() - 2);
+        }
+        std::string schema = to_lower(field("schema_name"));
+
+        // SHOW ALL TABLES and a bare DESCRIBE expand to every table of every database
+        if (type == "SHOW_REF" && (table == "__show_tables_expanded" || table == "databases")) {
+            return "Queries may not read catalog metadata (SHOW " + table + ")";
+        }
+        if (schema == "information_schema" || schema == "pg_catalog" || starts_with(table, "duckdb_") ||
+            starts_with(table, "pragma_") || starts_with(table, "pg_") || starts_with(table, "sqlite_")) {
+            return "Queries may not read catalog metadata (" + (schema.empty() ? table : schema) + ")";
+        }
+        if (starts_with(table, "__") || starts_with(schema, "__")) {
+            return "Names starting with \"__\" are reserved";
+        }
+        std::string error = check_catalog(field("catalog_name"), field("schema_name"), own_catalog);
+        if (!error.empty()) return error;
+    } else if (node.contains("function_name")) {
+        std::string function = to_lower(field("function_name"));
+        if (starts_with(function, "duckdb_") || starts_with(function, "pragma_")) {
+            return "Queries may not read catalog metadata (" + function + ")";
         }
+        if (function == "query" || function == "query_table") {
+            return "The " + function + "() function is not allowed";
+        }
+        if (starts_with(function, "__")) {
+            return "Names starting with \"__\" are reserved";
+        }
+        std::string error = check_catalog(field("catalog"), field("schema"), own_catalog);
+        if (!error.empty()) return error;
     }
 
-    // Check for multiple statements
-    if (std::count(sql.begin(), sql.end(), ';') > 1) {
-        return false;
+    for (const auto& child : node) {
+        if (!child.is_structured()) continue;
+        std::string error = check_references(child, own_catalog);
+        if (!error.empty()) return error;
     }
+    return "";
+}
 
-    return true;
+/**
+ * @brief Check what one parsed statement may reference
+ *
+ * A SELECT is serialized by DuckDB's json_serialize_sql() on the session's
+ * connection and its parse tree checked with check_references, so names
+ * in string literals, comments and aliases do not matter. Statements it
+ * cannot serialize fall back to check_reserved_names on their text.
+ */
+static std::string check_statement(DuckDBConnection& conn, const duckdb::SQLStatement& statement) {
+    std::string sql = statement_sql(statement);
+    if (statement.type == duckdb::StatementType::SELECT_STATEMENT) {
+        std::string own_catalog = conn.get_catalog_name().empty() ? "memory" : to_lower(conn.get_catalog_name());
+        try {
+            auto* conn_ptr = static_cast<duckdb::Connection*>(conn.get_connection());
+            auto result = conn_ptr->Query("SELECT json_serialize_sql($1)", sql);
+            auto chunk = result->HasError() ? nullptr : result->Fetch();
+            if (chunk && chunk->size() == 1) {
+                auto tree = nlohmann::json::parse(chunk->GetValue(0, 0).ToString());
+                if (!tree.value("error", true)) return check_references(tree["statements"], own_catalog);
+            }
+        } catch (const std::exception& e) {
+            // Fall back to the textual check
+        }
+    }
+    return check_reserved_names(sql);
+}
+
+ParsedQuery SQLExecutor::validate(
+    DuckDBConnection* conn,
+    const std::string& sql,
+    const std::vector<std::string>& allowed_statements
+) const {
+    if (!conn) {
+        ParsedQuery parsed;
+        parsed.error_message = "Invalid database connection";
+        return parsed;
+    }
+
+    ParsedQuery parsed = conn->parse(sql);
+    if (!parsed.is_valid()) return parsed;
+
+    if (parsed.statement_count() == 0) {
+        parsed.error_message = "No SQL statement to execute";
+        return parsed;
+    }
+
+    for (const auto& statement : parsed.statements->list) {
+        std::string type = statement_type_name(statement->type);
+        bool allowed = allowed_statements.empty()
+            ? type == "SELECT"
+            : std::find(allowed_statements.begin(), allowed_statements.end(), type) !=
+              allowed_statements.end();
+
+        if (!allowed) {
+            parsed.statements.reset();
+            parsed.error_message = type + " statements are not allowed for this question";
+            return parsed;
+        }
+    }
+
+    for (const auto& statement : parsed.statements->list) {
+        std::string reserved = check_statement(*conn, *statement);
+        if (!reserved.empty()) {
+            parsed.statements.reset();
+            parsed.error_message = reserved;
+            return parsed;
+        }
+    }
+
+    return parsed;
 }
 
 } // namespace sql_practice
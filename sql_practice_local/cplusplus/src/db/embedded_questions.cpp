@@ -108,7 +108,7 @@ static const QuestionDef question_3 = {
     "sql",
     "Amazon",
     "SELECT ",
-    "SELECT d.name as department, e.name as employee, e.salary FROM Employee e JOIN Department d ON e.department_id = d.id WHERE (e.department_id, e.salary) IN (SELECT department_id, MAX(salary) FROM Employee GROUP BY department_id)",
+    "SELECT d.name as department, e.name as employee, e.salary FROM Employee e JOIN Department d ON e.department_id = d.id JOIN (SELECT department_id, MAX(salary) AS max_salary FROM Employee GROUP BY department_id) m ON e.department_id = m.department_id AND e.salary = m.max_salary",
     {"window-functions", "joins", "group-by"},
     {
         "Use a CTE or subquery to find MAX salary per department",
@@ -191,7 +191,9 @@ static const QuestionDef question_4 = {
     },
     {"name"},
     {
-        {{"name", "Alice"}}
+        {{"name", "Alice"}},
+        {{"name", "Bob"}},
+        {{"name", "Charlie"}}
     }
 };
 
@@ -203,12 +205,12 @@ static const QuestionDef question_5 = {
     "q5",
     "Nth Highest Salary",
     "nth-highest-salary",
-    "Given an Employee table, write a SQL query to get the nth highest salary.",
+    "Given an Employee table, create a macro get_nth_highest_salary(n) returning the nth highest distinct salary, then select get_nth_highest_salary(2) AS get_nth_highest_salary.",
     "medium",
     "sql",
     "Facebook",
-    "CREATE FUNCTION getNthHighestSalary(N INT) ",
-    "CREATE FUNCTION getNthHighestSalary(N INT) RETURNS INT BEGIN DECLARE M INT; SET M = N - 1; RETURN (SELECT DISTINCT salary FROM Employee ORDER BY salary DESC LIMIT 1 OFFSET M); END",
+    "CREATE MACRO get_nth_highest_salary(n) AS ",
+    "CREATE MACRO get_nth_highest_salary(n) AS (SELECT DISTINCT salary FROM Employee ORDER BY salary DESC LIMIT 1 OFFSET n - 1); SELECT get_nth_highest_salary(2) AS get_nth_highest_salary",
     {"window-functions", "limit-offset", "dense-rank"},
     {
         "Use DENSE_RANK() or ROW_NUMBER() window function",
@@ -234,7 +236,8 @@ static const QuestionDef question_5 = {
         }}
     },
     {"get_nth_highest_salary"},
-    {{{"get_nth_highest_salary", "90000"}}}
+    {{{"get_nth_highest_salary", "90000"}}},
+    {"CREATE", "SELECT"}
 };
 
 // =============================================================================
@@ -245,12 +248,12 @@ static const QuestionDef question_6 = {
     "q6",
     "Rank Scores",
     "rank-scores",
-    "Write a SQL query to rank scores. If there is a tie between two scores, both should have the same ranking.",
+    "Write a SQL query to rank scores, ordered from the highest score to the lowest. If there is a tie between two scores, both should have the same ranking.",
     "medium",
     "sql",
     "LeetCode",
     "SELECT ",
-    "SELECT score, DENSE_RANK() OVER (ORDER BY score DESC) AS rank FROM Scores",
+    "SELECT score, DENSE_RANK() OVER (ORDER BY score DESC) AS rank FROM Scores ORDER BY score DESC",
     {"window-functions", "dense-rank"},
     {
         "Use DENSE_RANK() for consecutive ranking (1,2,2,3)",
@@ -280,7 +283,9 @@ static const QuestionDef question_6 = {
         {{"score", "95"}, {"rank", "1"}},
         {{"score", "85"}, {"rank", "2"}},
         {{"score", "75"}, {"rank", "3"}}
-    }
+    },
+    {},
+    "ordered"
 };
 
 // =============================================================================
@@ -291,12 +296,12 @@ static const QuestionDef question_7 = {
     "q7",
     "Delete Duplicate Emails",
     "delete-duplicate-emails",
-    "Delete all duplicate emails from the Person table, keeping only the one with the smallest ID.",
+    "Delete all duplicate emails from the Person table, keeping only the one with the smallest ID, then return the remaining rows with SELECT id, email FROM Person.",
     "medium",
     "sql",
     "Google",
-    "DELETE p1 FROM Person p1, Person p2 ",
-    "DELETE p1 FROM Person p1, Person p2 WHERE p1.email = p2.email AND p1.id > p2.id",
+    "DELETE FROM Person ",
+    "DELETE FROM Person WHERE id IN (SELECT p1.id FROM Person p1 JOIN Person p2 ON p1.email = p2.email AND p1.id > p2.id); SELECT id, email FROM Person",
     {"delete", "self-join"},
     {
         "Join Person table with itself on email",
@@ -323,7 +328,8 @@ static const QuestionDef question_7 = {
     {
         {{"id", "1"}, {"email", "alice@example.com"}},
         {{"id", "2"}, {"email", "bob@example.com"}}
-    }
+    },
+    {"DELETE", "SELECT"}
 };
 
 // =============================================================================
@@ -339,7 +345,7 @@ static const QuestionDef question_8 = {
     "sql",
     "Microsoft",
     "SELECT ",
-    "SELECT DISTINCT l1.num FROM Logs l1 JOIN Logs l2 ON l1.id = l2.id - 1 AND l1.num = l2.num JOIN Logs l3 ON l1.id = l3.id - 2 AND l1.num = l3.num",
+    "SELECT DISTINCT l1.num AS consecutive_numbers FROM Logs l1 JOIN Logs l2 ON l1.id = l2.id - 1 AND l1.num = l2.num JOIN Logs l3 ON l1.id = l3.id - 2 AND l1.num = l3.num",
     {"joins", "self-join"},
     {
         "Join the Logs table with itself twice",
@@ -410,7 +416,7 @@ static const QuestionDef question_9 = {
         }}
     },
     {"customer_id"},
-    {{{"customer_id", "1"}}}
+    {{{"customer_id", "3"}}}
 };
 
 // =============================================================================
@@ -426,7 +432,7 @@ static const QuestionDef question_10 = {
     "advanced-sql",
     "Netflix",
     "SELECT ",
-    "SELECT DISTINCT a1.actor_id, a2.actor_id FROM Actor a1 CROSS JOIN Actor a2 WHERE a1.actor_id < a2.actor_id AND NOT EXISTS (SELECT 1 FROM Movie_Actor ma1 JOIN Movie_Actor ma2 ON ma1.movie_id = ma2.movie_id WHERE ma1.actor_id = a1.actor_id AND ma2.actor_id = a2.actor_id)",
+    "SELECT DISTINCT a1.actor_id AS actor1_id, a2.actor_id AS actor2_id FROM Actor a1 CROSS JOIN Actor a2 WHERE a1.actor_id < a2.actor_id AND NOT EXISTS (SELECT 1 FROM Movie_Actor ma1 JOIN Movie_Actor ma2 ON ma1.movie_id = ma2.movie_id WHERE ma1.actor_id = a1.actor_id AND ma2.actor_id = a2.actor_id)",
     {"cross-join", "not-exists", "subqueries"},
     {
         "Use CROSS JOIN to get all possible actor pairs",
@@ -51,6 +51,8 @@ struct QuestionDef {
     std::unordered_map<const char*, std::vector<DataRow>> sample_data;
     std::vector<const char*> expected_columns;
     std::vector<DataRow> expected_rows;
+    std::vector<const char*> allowed_statements = {};  // Statement types students may run; empty = SELECT only
+    const char* grading = nullptr;  // "ordered" when row order matters; unordered otherwise
 };
 
 /**
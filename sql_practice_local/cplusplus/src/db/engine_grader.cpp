@@ -0,0 +1,231 @@
+#include "include/engine_grader.hpp"
+#include "include/fixture_catalog.hpp"
+#include "include/instance_pool.hpp"
+#include "include/question_loader.hpp"
+#include "include/config.hpp"
+#include <duckdb.hpp>
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace sql_practice {
+
+// =============================================================================
+// EngineGrader Implementation
+// =============================================================================
+
+/**
+ * @brief Macros reducing a cell to the text of its CanonicalCell value
+ *
+ * Every value is read through its VARCHAR form, the way CanonicalCell reads
+ * text: what std::from_chars takes as an int64 becomes that integer, what
+ * it takes as a double becomes the integer (when integral and in range),
+ * 'nan' or the double's shortest text, and anything else stays as is.
+ * Booleans therefore compare as 'true' / 'false'.
+ */
+static const char* const CANONICAL_MACROS[] = {
+    "CREATE OR REPLACE TEMP MACRO __canon_double(d) AS ("
+    "CASE"
+    " WHEN isnan(d) THEN 'nan'"
+    " WHEN isfinite(d) AND d = trunc(d) AND d >= -9223372036854775808.0 AND d < 9223372036854775808.0"
+    "  THEN CAST(CAST(d AS BIGINT) AS VARCHAR)"
+    " ELSE CAST(d AS VARCHAR) "
+    "END)",
+
+    "CREATE OR REPLACE TEMP MACRO __canon_cell(v) AS ("
+    "CASE"
+    " WHEN v IS NULL THEN NULL"
+    " WHEN regexp_full_match(CAST(v AS VARCHAR), '-?[0-9]+')"
+    "  AND TRY_CAST(CAST(v AS VARCHAR) AS BIGINT) IS NOT NULL"
+    "  THEN CAST(TRY_CAST(CAST(v AS VARCHAR) AS BIGINT) AS VARCHAR)"
+    " WHEN regexp_full_match(CAST(v AS VARCHAR),"
+    "  '(?i)-?(([0-9]+\\.?[0-9]*|\\.[0-9]+)(e[+-]?[0-9]+)?|inf(inity)?|nan)')"
+    "  THEN COALESCE(__canon_double(TRY_CAST(CAST(v AS VARCHAR) AS DOUBLE)), CAST(v AS VARCHAR))"
+    " ELSE CAST(v AS VARCHAR) "
+    "END)",
+};
+
+/**
+ * @brief Column type holding a result column's values without conversion
+ */
+static const char* expected_column_type(ColumnKind kind) {
+    switch (kind) {
+        case ColumnKind::BOOLEAN: return "BOOLEAN";
+        case ColumnKind::INTEGER: return "BIGINT";
+        case ColumnKind::DOUBLE: return "DOUBLE";
+        case ColumnKind::TEXT: return "VARCHAR";
+    }
+    return "VARCHAR";
+}
+
+/**
+ * @brief Write a question's expected output to EXPECTED_CATALOG."<id>".EXPECTED_TABLE
+ */
+static bool load_expected_output(DuckDBConnection& conn, const Question& question) {
+    const auto& expected = question.expected_output;
+    std::string schema = std::string(EngineGrader::EXPECTED_CATALOG) + ".\"" + question.id + "\"";
+
+    std::string create = "CREATE TABLE " + schema + "." + EngineGrader::EXPECTED_TABLE + " (";
+    for (size_t col = 0; col < expected.data.size(); ++col) {
+        if (col > 0) create += ", ";
+        create += "c" + std::to_string(col) + " " + expected_column_type(expected.data[col].kind);
+    }
+    create += ")";
+
+    if (!conn.execute("CREATE SCHEMA " + schema).success || !conn.execute(create).success) {
+        return false;
+    }
+
+    try {
+        auto* conn_ptr = static_cast<duckdb::Connection*>(conn.get_connection());
+        duckdb::Appender appender(*conn_ptr, EngineGrader::EXPECTED_CATALOG, question.id,
+                                  EngineGrader::EXPECTED_TABLE);
+        for (size_t row = 0; row < static_cast<size_t>(std::max(expected.row_count, 0)); ++row) {
+            appender.BeginRow();
+            for (const auto& column : expected.data) {
+                if (column.is_null(row)) {
+                    appender.Append(nullptr);
+                    continue;
+                }
+                switch (column.kind) {
+                    case ColumnKind::BOOLEAN: appender.Append<bool>(column.ints[row] != 0); break;
+                    case ColumnKind::INTEGER: appender.Append<int64_t>(column.ints[row]); break;
+                    case ColumnKind::DOUBLE: appender.Append<double>(column.doubles[row]); break;
+                    case ColumnKind::TEXT:
+                        appender.Append(column.strings[row].c_str(),
+                                        static_cast<uint32_t>(column.strings[row].size()));
+                        break;
+                }
+            }
+            appender.EndRow();
+        }
+        appender.Close();
+        return true;
+    } catch (const std::exception& e) {
+        conn.execute("DROP SCHEMA IF EXISTS " + schema + " CASCADE");
+        return false;
+    }
+}
+
+EngineGrader::EngineGrader(const FixtureCatalog& catalog, const QuestionLoader& loader, size_t budget_shares) {
+    size_t workers = static_cast<size_t>(std::max(Config::query_workers, 1));
+    pool = std::make_shared<DuckDBInstancePool>(1, workers, budget_shares);
+    pool->set_fixture_catalog(catalog.get_path(), catalog.get_version());
+
+    auto setup = open_connection();
+    if (!setup->has_fixture_catalog()) {
+        // Nothing to grade against; every question stays with the C++ grader
+        idle.push_back(std::move(setup));
+        return;
+    }
+
+    // Attached on the grading instance only, so no session instance can reach it
+    auto attach = setup->execute(std::string("ATTACH ':memory:' AS ") + EXPECTED_CATALOG);
+    if (!attach.success) {
+        throw std::runtime_error("Failed to create the expected-output catalog: " + attach.error_message);
+    }
+
+    std::unordered_set<std::string> fixture_schemas;
+    auto schemas = setup->execute(std::string("SELECT schema_name FROM duckdb_schemas() WHERE database_name = '") +
+                                  FixtureCatalog::CATALOG_NAME + "'");
+    for (size_t row = 0; schemas.success && row < static_cast<size_t>(schemas.row_count); ++row) {
+        fixture_schemas.insert(schemas.data[0].to_string(row));
+    }
+
+    for (const auto& question : loader.get_all_questions()) {
+        if (!question->expected_output.success || question->expected_output.columns.empty()) continue;
+        if (!fixture_schemas.count(FixtureCatalog::schema_for(question->id))) continue;
+
+        if (load_expected_output(*setup, *question)) {
+            questions.insert(question->id);
+        }
+    }
+
+    idle.push_back(std::move(setup));
+}
+
+EngineGrader::~EngineGrader() = default;
+
+std::unique_ptr<DuckDBConnection> EngineGrader::open_connection() {
+    auto conn = std::make_unique<DuckDBConnection>(pool);
+    for (const char* macro : CANONICAL_MACROS) {
+        auto result = conn->execute(macro);
+        if (!result.success) {
+            throw std::runtime_error("Failed to create grading macros: " + result.error_message);
+        }
+    }
+    return conn;
+}
+
+QueryResult EngineGrader::grade(const std::string& select_sql, const Question& question, int timeout_ms) {
+    QueryResult result;
+    const auto& expected = question.expected_output;
+    if (!covers(question.id) || select_sql.empty()) {
+        result.error_message = "In-engine grading unavailable";
+        return result;
+    }
+
+    std::unique_ptr<DuckDBConnection> conn;
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        if (!idle.empty()) {
+            conn = std::move(idle.back());
+            idle.pop_back();
+        }
+    }
+    if (!conn) {
+        try {
+            conn = open_connection();
+        } catch (const std::exception& e) {
+            result.error_message = e.what();
+            return result;
+        }
+    }
+
+    // A trailing ';' would end the CTE early
+    std::string body = select_sql;
+    while (!body.empty() && (body.back() == ';' || std::isspace(static_cast<unsigned char>(body.back())))) {
+        body.pop_back();
+    }
+
+    std::string names;
+    std::string canonical;
+    for (size_t col = 0; col < expected.columns.size(); ++col) {
+        std::string name = "c" + std::to_string(col);
+        names += (col > 0 ? ", " : "") + name;
+        canonical += (col > 0 ? ", " : "") + ("__canon_cell(" + name + ") AS " + name);
+    }
+
+    // Newlines keep a trailing line comment in the submission from eating the ')'.
+    // __actual is read twice, so it is materialized to run the submission once
+    std::string sql =
+        "WITH __submission AS (\n" + body + "\n), "
+        "__actual AS MATERIALIZED (SELECT " + canonical + " FROM __submission AS __s(" + names + ")), "
+        "__wanted AS (SELECT " + canonical + " FROM " + EXPECTED_CATALOG + ".\"" + question.id + "\"." +
+        EXPECTED_TABLE + ") "
+        "SELECT count(*) FROM ("
+        "(SELECT * FROM __actual EXCEPT ALL SELECT * FROM __wanted) "
+        "UNION ALL "
+        "(SELECT * FROM __wanted EXCEPT ALL SELECT * FROM __actual))";
+
+    ResultLimits limits;
+    limits.timeout_ms = timeout_ms;
+
+    auto path = conn->execute(std::string("SET search_path = '") + FixtureCatalog::CATALOG_NAME + ".\"" +
+                              FixtureCatalog::schema_for(question.id) + "\"'");
+    if (path.success) {
+        result = conn->execute(sql, limits);
+        if (result.success) {
+            result.is_correct = result.row_count == 1 && result.data.size() == 1 &&
+                                !result.data[0].is_null(0) && result.data[0].ints[0] == 0;
+        }
+    } else {
+        result = std::move(path);
+    }
+
+    std::lock_guard<std::mutex> lock(idle_mutex);
+    idle.push_back(std::move(conn));
+    return result;
+}
+
+} // namespace sql_practice
@@ -0,0 +1,67 @@
+#include "include/fixture_catalog.hpp"
+#include "include/question_loader.hpp"
+#include "include/sql_executor.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace sql_practice {
+
+// =============================================================================
+// FixtureCatalog Implementation
+// =============================================================================
+
+FixtureCatalog::FixtureCatalog(const std::string& path) : db_path(path), version(0) {
+    if (db_path.empty()) {
+        auto file = std::filesystem::temp_directory_path() /
+                    ("sql_practice_fixtures_" + std::to_string(::getpid()) + ".duckdb");
+        db_path = file.string();
+    }
+}
+
+FixtureCatalog::~FixtureCatalog() {
+    std::remove(db_path.c_str());
+    std::remove((db_path + ".wal").c_str());
+}
+
+std::string FixtureCatalog::schema_for(const std::string& question_id) {
+    return question_id;
+}
+
+size_t FixtureCatalog::build(const QuestionLoader& loader) {
+    // Start from an empty file so stale fixtures never leak into a new build
+    std::remove(db_path.c_str());
+    std::remove((db_path + ".wal").c_str());
+
+    version = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+
+    size_t built = 0;
+    {
+        DuckDBConnection conn(db_path);
+        if (!conn.get_connection()) {
+            throw std::runtime_error("Failed to create fixture database at " + db_path);
+        }
+
+        SQLExecutor executor;
+        for (const auto& question : loader.get_all_questions()) {
+            std::string schema = schema_for(question->id);
+
+            auto create_result = conn.execute("CREATE SCHEMA \"" + schema + "\"");
+            if (!create_result.success) continue;
+
+            if (executor.initialize_schema(&conn, question->schema, schema)) {
+                built++;
+            } else {
+                conn.execute("DROP SCHEMA \"" + schema + "\" CASCADE");
+            }
+        }
+
+        conn.execute("CHECKPOINT");
+    }
+
+    return built;
+}
+
+} // namespace sql_practice
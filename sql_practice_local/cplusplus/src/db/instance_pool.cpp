@@ -0,0 +1,154 @@
+#include "include/instance_pool.hpp"
+#include "include/fixture_catalog.hpp"
+#include "include/resource_governor.hpp"
+#include <duckdb.hpp>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace sql_practice {
+
+// =============================================================================
+// DuckDBInstancePool Implementation
+// =============================================================================
+
+/**
+ * @brief Detach the default "memory" catalog of a new instance
+ *
+ * Every connection to an instance starts in "memory", so a table created
+ * there would be visible to every session on the instance. Sessions
+ * attach and USE their own catalog instead, leaving nothing for memory to
+ * hold. A connection cannot detach the catalog it is using, so one moves
+ * to a scratch catalog to drop memory and a second drops the scratch.
+ * Connections then start without a default catalog until they USE one.
+ */
+static void detach_default_catalog(duckdb::DuckDB& db) {
+    {
+        duckdb::Connection setup(db);
+        auto result = setup.Query("ATTACH ':memory:' AS __setup; USE __setup; DETACH memory");
+        if (result->HasError()) {
+            throw std::runtime_error("Failed to detach the default catalog: " + result->GetError());
+        }
+    }
+    duckdb::Connection cleanup(db);
+    auto result = cleanup.Query("DETACH __setup");
+    if (result->HasError()) {
+        throw std::runtime_error("Failed to detach the default catalog: " + result->GetError());
+    }
+}
+
+DuckDBInstancePool::DuckDBInstancePool(size_t instance_count, size_t per_instance, size_t shares)
+    : connections_per_instance(std::max<size_t>(per_instance, 1)) {
+    instance_count = std::max<size_t>(instance_count, 1);
+    budget_shares = std::max(shares, instance_count);
+    instances.reserve(instance_count);
+    for (size_t i = 0; i < instance_count; ++i) {
+        instances.push_back(std::make_unique<Instance>());
+    }
+}
+
+DuckDBInstancePool::~DuckDBInstancePool() = default;
+
+size_t DuckDBInstancePool::instances_for(size_t max_sessions, size_t per_instance) {
+    per_instance = std::max<size_t>(per_instance, 1);
+    return std::max<size_t>((max_sessions + per_instance - 1) / per_instance, 1);
+}
+
+InstanceLease DuckDBInstancePool::acquire() {
+    std::lock_guard<std::mutex> lock(assign_mutex);
+
+    // Least-loaded assignment; ties go to the lowest index
+    size_t best = 0;
+    size_t best_load = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < instances.size(); ++i) {
+        size_t load = instances[i]->active.load(std::memory_order_relaxed);
+        if (load < best_load) {
+            best = i;
+            best_load = load;
+        }
+    }
+
+    auto& instance = *instances[best];
+    if (!instance.db) {
+        // The configured limits are server-wide; each instance gets an equal share
+        duckdb::DBConfig config;
+        apply_resource_limits(config, budget_shares);
+        auto db = std::make_unique<duckdb::DuckDB>(nullptr, &config);
+        detach_default_catalog(*db);
+        instance.db = std::move(db);
+        attach_fixtures(instance);
+    }
+
+    size_t active = instance.active.fetch_add(1, std::memory_order_relaxed) + 1;
+    instance.total.fetch_add(1, std::memory_order_relaxed);
+    if (active > instance.peak.load(std::memory_order_relaxed)) {
+        instance.peak.store(active, std::memory_order_relaxed);
+    }
+
+    return InstanceLease{best, instance.db.get(), instance.has_fixtures};
+}
+
+void DuckDBInstancePool::release(size_t instance_id) {
+    if (instance_id >= instances.size()) return;
+    instances[instance_id]->active.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void DuckDBInstancePool::set_fixture_catalog(const std::string& path, uint64_t version) {
+    std::lock_guard<std::mutex> lock(assign_mutex);
+    fixture_path = path;
+    fixture_version.store(version, std::memory_order_relaxed);
+    for (auto& instance : instances) {
+        if (instance->db && !instance->has_fixtures) {
+            attach_fixtures(*instance);
+        }
+    }
+}
+
+bool DuckDBInstancePool::attach_fixtures(Instance& instance) {
+    if (fixture_path.empty()) return false;
+
+    // Escape single quotes in the path for the ATTACH literal
+    std::string escaped;
+    for (char c : fixture_path) {
+        if (c == '\'') escaped += "''";
+        else escaped += c;
+    }
+
+    duckdb::Connection setup(*instance.db);
+    auto result = setup.Query("ATTACH '" + escaped + "' AS " +
+                              FixtureCatalog::CATALOG_NAME + " (READ_ONLY)");
+    instance.has_fixtures = !result->HasError();
+    return instance.has_fixtures;
+}
+
+std::vector<InstanceLoadStats> DuckDBInstancePool::get_load_stats() const {
+    std::lock_guard<std::mutex> lock(assign_mutex);
+
+    std::vector<InstanceLoadStats> stats;
+    stats.reserve(instances.size());
+    for (size_t i = 0; i < instances.size(); ++i) {
+        const auto& instance = *instances[i];
+        uint64_t used = 0;
+        uint64_t limit = 0;
+        size_t threads = 0;
+        if (instance.db) {
+            const auto& buffers = instance.db->instance->GetBufferManager();
+            used = buffers.GetUsedMemory();
+            limit = buffers.GetMaxMemory();
+            threads = static_cast<size_t>(instance.db->NumberOfThreads());
+        }
+        stats.push_back(InstanceLoadStats{
+            i,
+            instance.db != nullptr,
+            instance.active.load(std::memory_order_relaxed),
+            instance.peak.load(std::memory_order_relaxed),
+            instance.total.load(std::memory_order_relaxed),
+            used,
+            limit,
+            threads
+        });
+    }
+    return stats;
+}
+
+} // namespace sql_practice
@@ -0,0 +1,58 @@
+#include "include/sql_executor.hpp"
+#include <charconv>
+#include <cmath>
+
+namespace sql_practice {
+
+// =============================================================================
+// ResultColumn Implementation
+// =============================================================================
+
+std::string_view ResultColumn::text(size_t row, char (&buffer)[32]) const {
+    if (is_null(row)) return "NULL";
+
+    switch (kind) {
+        case ColumnKind::BOOLEAN:
+            return ints[row] ? "true" : "false";
+        case ColumnKind::INTEGER: {
+            auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), ints[row]);
+            return std::string_view(buffer, static_cast<size_t>(end - buffer));
+        }
+        case ColumnKind::DOUBLE: {
+            double value = doubles[row];
+            if (std::isnan(value)) return "nan";
+            if (std::isinf(value)) return value < 0 ? "-inf" : "inf";
+
+            // Shortest round-trip form, with ".0" on integral values as DuckDB prints them
+            auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer) - 2, value);
+            std::string_view digits(buffer, static_cast<size_t>(end - buffer));
+            if (digits.find_first_of(".e") == std::string_view::npos) {
+                *end++ = '.';
+                *end++ = '0';
+            }
+            return std::string_view(buffer, static_cast<size_t>(end - buffer));
+        }
+        case ColumnKind::TEXT:
+            return strings[row];
+    }
+    return std::string_view();
+}
+
+std::string ResultColumn::to_string(size_t row) const {
+    char buffer[32];
+    return std::string(text(row, buffer));
+}
+
+// =============================================================================
+// QueryResult Implementation
+// =============================================================================
+
+bool QueryResult::row_equals(size_t row, const QueryResult& other, size_t other_row) const {
+    if (data.size() != other.data.size()) return false;
+    for (size_t col = 0; col < data.size(); ++col) {
+        if (!data[col].cell_equals(row, other.data[col], other_row)) return false;
+    }
+    return true;
+}
+
+} // namespace sql_practice
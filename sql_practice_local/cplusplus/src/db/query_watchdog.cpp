@@ -0,0 +1,85 @@
+#include "include/query_watchdog.hpp"
+#include <duckdb.hpp>
+
+namespace sql_practice {
+
+// =============================================================================
+// QueryWatchdog Implementation
+// =============================================================================
+
+QueryWatchdog::QueryWatchdog()
+    : next_id(1), stopping(false), timeout_count(0) {
+    worker = std::thread([this]() { run(); });
+}
+
+QueryWatchdog::~QueryWatchdog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+QueryWatchdog& QueryWatchdog::shared() {
+    static QueryWatchdog watchdog;
+    return watchdog;
+}
+
+uint64_t QueryWatchdog::arm(duckdb::Connection* conn, int timeout_ms) {
+    auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t handle = next_id++;
+    auto it = deadlines.emplace(deadline, handle);
+    armed.emplace(handle, Entry{conn, it, false});
+
+    // Only a new earliest deadline changes when the worker must wake up
+    if (it == deadlines.begin()) {
+        wakeup.notify_one();
+    }
+    return handle;
+}
+
+bool QueryWatchdog::disarm(uint64_t handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = armed.find(handle);
+    if (it == armed.end()) return false;
+
+    bool fired = it->second.fired;
+    if (!fired) {
+        deadlines.erase(it->second.deadline);
+    }
+    armed.erase(it);
+    return fired;
+}
+
+void QueryWatchdog::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (deadlines.empty()) {
+            wakeup.wait(lock);
+            continue;
+        }
+
+        auto now = Clock::now();
+        auto next = deadlines.begin()->first;
+        if (now < next) {
+            wakeup.wait_until(lock, next);
+            continue;
+        }
+
+        // Interrupt every query whose deadline has passed
+        while (!deadlines.empty() && deadlines.begin()->first <= now) {
+            auto& entry = armed.at(deadlines.begin()->second);
+            entry.fired = true;
+            deadlines.erase(deadlines.begin());
+            entry.conn->Interrupt();
+            timeout_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace sql_practice
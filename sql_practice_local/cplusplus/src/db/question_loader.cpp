@@ -1,7 +1,7 @@
 #include "include/question_loader.hpp"
 #include "db/embedded_questions.hpp"
 #include <algorithm>
-#include <optional>
+#include <memory>
 #include <unordered_set>
 
 namespace sql_practice {
@@ -22,6 +22,7 @@ void QuestionLoader::load_embedded_questions() {
         q.company = eq.company ? eq.company : "";
         q.starter_code = eq.starter_code ? eq.starter_code : "";
         q.solution = eq.solution ? eq.solution : "";
+        q.grade_mode = grade_mode_from(eq.grading ? eq.grading : "");
 
         // Convert tags
         for (const auto& tag : eq.tags) {
@@ -33,6 +34,11 @@ void QuestionLoader::load_embedded_questions() {
             q.hints.push_back(hint);
         }
 
+        // Convert allowed statement types
+        for (const auto& statement : eq.allowed_statements) {
+            q.allowed_statements.push_back(statement);
+        }
+
         // Convert schema
         for (const auto& table : eq.tables) {
             QuestionSchema::Table schema_table;
@@ -64,63 +70,74 @@ void QuestionLoader::load_embedded_questions() {
         // Convert expected output
         for (const auto& col : eq.expected_columns) {
             q.expected_output.columns.push_back(col);
+            q.expected_output.data.emplace_back(ColumnKind::TEXT);
         }
         for (const auto& row : eq.expected_rows) {
-            std::unordered_map<std::string, std::string> std_row;
-            for (const auto& [key, value] : row) {
-                std_row[key] = value;
+            for (size_t i = 0; i < q.expected_output.columns.size(); ++i) {
+                const auto& name = q.expected_output.columns[i];
+                auto& column = q.expected_output.data[i];
+                auto it = std::find_if(row.begin(), row.end(), [&](const auto& cell) {
+                    return name == cell.first;
+                });
+                if (it == row.end() || std::string(it->second) == "NULL") {
+                    column.append_null();
+                } else {
+                    column.append_text(it->second);
+                }
             }
-            q.expected_output.rows.push_back(std_row);
         }
+        q.expected_output.row_count = static_cast<int>(eq.expected_rows.size());
         // Mark expected output as valid for comparison
         q.expected_output.success = true;
+        q.expected_fingerprint = fingerprint_result(q.expected_output);
 
-        // Store in maps
-        if (!q.id.empty()) {
-            questions_by_id[q.id] = q;
+        // Store in maps, both pointing at one instance
+        auto question = std::make_shared<const Question>(std::move(q));
+        if (!question->id.empty()) {
+            questions_by_id[question->id] = question;
         }
-        if (!q.slug.empty()) {
-            questions_by_slug[q.slug] = q;
+        if (!question->slug.empty()) {
+            questions_by_slug[question->slug] = question;
         }
     }
 }
 
-std::optional<Question> QuestionLoader::get_question_by_slug(const std::string& slug) const {
+std::shared_ptr<const Question> QuestionLoader::get_question_by_slug(const std::string& slug) const {
     auto it = questions_by_slug.find(slug);
     if (it != questions_by_slug.end()) {
         return it->second;
     }
-    return std::nullopt;
+    return nullptr;
 }
 
-std::optional<Question> QuestionLoader::get_question_by_id(const std::string& id) const {
+std::shared_ptr<const Question> QuestionLoader::get_question_by_id(const std::string& id) const {
     auto it = questions_by_id.find(id);
     if (it != questions_by_id.end()) {
         return it->second;
     }
-    return std::nullopt;
+    return nullptr;
 }
 
-std::vector<Question> QuestionLoader::list_questions(
+std::vector<std::shared_ptr<const Question>> QuestionLoader::list_questions(
     const std::string& difficulty,
     const std::string& category,
     const std::string& tag,
     int skip,
     int limit
 ) const {
-    std::vector<Question> result;
+    std::vector<std::shared_ptr<const Question>> result;
 
     for (const auto& [slug, question] : questions_by_slug) {
         // Apply filters
-        if (!difficulty.empty() && question.question_difficulty != difficulty) {
+        if (!difficulty.empty() && question->question_difficulty != difficulty) {
             continue;
         }
-        if (!category.empty() && question.category != category) {
+        if (!category.empty() && question->category != category) {
             continue;
         }
         if (!tag.empty()) {
-            auto it = std::find(question.tags.begin(), question.tags.end(), tag);
-            if (it == question.tags.end()) {
+            auto it = std::find(question->tags.begin(), question->tags.end(), tag);
+            if (it == question->tags.end()) {
                 continue;
             }
         }
@@ -129,11 +146,11 @@ std::vector<Question> QuestionLoader::list_questions(
     }
 
     // Sort by difficulty then title
-    std::sort(result.begin(), result.end(), [](const Question& a, const Question& b) {
-        if (a.question_difficulty != b.question_difficulty) {
-            return a.question_difficulty < b.question_difficulty;
+    std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+        if (a->question_difficulty != b->question_difficulty) {
+            return a->question_difficulty < b->question_difficulty;
         }
-        return a.title < b.title;
+        return a->title < b->title;
     });
 
     // Apply pagination
@@ -141,18 +158,45 @@ std::vector<Question> QuestionLoader::list_questions(
     int end = std::min(skip + limit, static_cast<int>(result.size()));
 
     if (start < static_cast<int>(result.size())) {
-        return std::vector<Question>(result.begin() + start, result.begin() + end);
+        return std::vector<std::shared_ptr<const Question>>(result.begin() + start, result.begin() + end);
     }
 
     return {};
 }
 
+std::vector<std::shared_ptr<const Question>> QuestionLoader::get_all_questions() const {
+    std::vector<std::shared_ptr<const Question>> result;
+    result.reserve(questions_by_id.size());
+    for (const auto& [id, question] : questions_by_id) {
+        result.push_back(question);
+    }
+    return result;
+}
+
+bool QuestionLoader::set_expected_output(const std::string& id, QueryResult expected) {
+    auto it = questions_by_id.find(id);
+    if (it == questions_by_id.end()) return false;
+
+    auto question = std::make_shared<Question>(*it->second);
+    expected.success = true;
+    expected.error_message.clear();
+    question->expected_fingerprint = fingerprint_result(expected);
+    question->expected_output = std::move(expected);
+    it->second = question;
+
+    auto by_slug = questions_by_slug.find(question->slug);
+    if (by_slug != questions_by_slug.end()) {
+        by_slug->second = question;
+    }
+    return true;
+}
+
 std::vector<std::string> QuestionLoader::get_all_tags() const {
     std::vector<std::string> tags;
     std::unordered_set<std::string> seen;
 
     for (const auto& [slug, question] : questions_by_slug) {
-        for (const auto& tag : question.tags) {
+        for (const auto& tag : question->tags) {
             if (seen.find(tag) == seen.end()) {
                 seen.insert(tag);
                 tags.push_back(tag);
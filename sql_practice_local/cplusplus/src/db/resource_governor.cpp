@@ -0,0 +1,57 @@
+#include "include/resource_governor.hpp"
+#include "include/config.hpp"
+#include <duckdb.hpp>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace sql_practice {
+
+// =============================================================================
+// Resource Governor
+// =============================================================================
+
+/**
+ * @brief A size setting ("1GB", "512MB", ...) divided into equal shares, in bytes
+ */
+static std::string size_share(const std::string& setting, size_t shares) {
+    duckdb::idx_t bytes = duckdb::DBConfig::ParseMemoryLimit(setting);
+    return std::to_string(std::max<duckdb::idx_t>(bytes / shares, 1)) + "B";
+}
+
+void apply_resource_limits(duckdb::DBConfig& config, size_t instance_count) {
+    // Temp subdirectories only need to be unique per process
+    static std::atomic<uint64_t> next_instance{0};
+    size_t shares = std::max<size_t>(instance_count, 1);
+
+    if (!Config::duckdb_memory_limit.empty()) {
+        config.SetOptionByName("memory_limit",
+                               duckdb::Value(size_share(Config::duckdb_memory_limit, shares)));
+    }
+
+    size_t threads = Config::duckdb_threads > 0
+        ? static_cast<size_t>(Config::duckdb_threads)
+        : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    config.SetOptionByName("threads", duckdb::Value::BIGINT(
+        static_cast<int64_t>(std::max<size_t>(threads / shares, 1))));
+
+    // DuckDB's default for in-memory databases is .tmp in the working directory.
+    // DuckDB creates (and removes) the instance's own directory on first spill,
+    // but not its parents
+    std::string temp_root = Config::duckdb_temp_directory.empty() ? ".tmp" : Config::duckdb_temp_directory;
+    while (temp_root.size() > 1 && temp_root.back() == '/') temp_root.pop_back();
+    std::error_code ignored;
+    std::filesystem::create_directories(temp_root, ignored);
+    config.SetOptionByName("temp_directory", duckdb::Value(
+        temp_root + "/inst_" + std::to_string(next_instance.fetch_add(1, std::memory_order_relaxed))));
+
+    if (!Config::duckdb_max_temp_directory_size.empty()) {
+        config.SetOptionByName("max_temp_directory_size",
+                               duckdb::Value(size_share(Config::duckdb_max_temp_directory_size, shares)));
+    }
+}
+
+} // namespace sql_practice
@@ -0,0 +1,169 @@
+#include "include/result_fingerprint.hpp"
+#include <duckdb.hpp>
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+
+namespace sql_practice {
+
+// =============================================================================
+// Cell and row hashing
+// =============================================================================
+
+using RowHash = FingerprintSink::RowHash;
+
+static constexpr RowHash ROW_SEED = {0xcbf29ce484222325ULL, 0x6a09e667f3bcc909ULL};
+
+/**
+ * @brief Fold one cell into its row's running hash (column order matters)
+ */
+static inline void combine(RowHash& row_hash, const CanonicalCell& cell) {
+    row_hash.lane = ((row_hash.lane << 23) | (row_hash.lane >> 41)) ^ cell.hash();
+    row_hash.lane *= 0x9e3779b97f4a7c15ULL;
+    row_hash.alt_lane = ((row_hash.alt_lane << 29) | (row_hash.alt_lane >> 35)) ^ cell.alt_hash();
+    row_hash.alt_lane *= 0xd6e8feb86659fd93ULL;
+}
+
+/**
+ * @brief Add finished row hashes to a fingerprint
+ */
+static inline void accumulate(ResultFingerprint& fingerprint, const std::vector<RowHash>& row_hashes) {
+    for (const auto& row_hash : row_hashes) {
+        fingerprint.row_hash_sum += CanonicalCell::mix64(row_hash.lane);
+        fingerprint.row_hash_sum_alt += CanonicalCell::mix64(row_hash.alt_lane);
+    }
+}
+
+// =============================================================================
+// fingerprint_result
+// =============================================================================
+
+ResultFingerprint fingerprint_result(const QueryResult& result) {
+    ResultFingerprint fingerprint;
+    size_t rows = static_cast<size_t>(std::max(result.row_count, 0));
+
+    std::vector<RowHash> row_hashes(rows, ROW_SEED);
+    for (const auto& column : result.data) {
+        for (size_t row = 0; row < rows; ++row) {
+            combine(row_hashes[row], column.canonical(row));
+        }
+    }
+
+    accumulate(fingerprint, row_hashes);
+    fingerprint.row_count = rows;
+    return fingerprint;
+}
+
+// =============================================================================
+// FingerprintSink Implementation
+// =============================================================================
+
+template <typename T>
+static void hash_numeric_vector(std::vector<RowHash>& row_hashes, duckdb::Vector& vector, size_t count) {
+    duckdb::UnifiedVectorFormat format;
+    vector.ToUnifiedFormat(count, format);
+    auto values = duckdb::UnifiedVectorFormat::GetData<T>(format);
+
+    for (size_t row = 0; row < count; ++row) {
+        auto idx = format.sel->get_index(row);
+        CanonicalCell cell;
+        if (!format.validity.RowIsValid(idx)) {
+            cell = CanonicalCell::null();
+        } else if constexpr (std::is_same_v<T, bool>) {
+            cell = CanonicalCell::from_bool(values[idx]);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            cell = CanonicalCell::from_double(static_cast<double>(values[idx]));
+        } else if constexpr (std::is_same_v<T, uint64_t>) {
+            cell = CanonicalCell::from_unsigned(values[idx]);
+        } else {
+            cell = CanonicalCell::from_int(static_cast<int64_t>(values[idx]));
+        }
+        combine(row_hashes[row], cell);
+    }
+}
+
+static void hash_string_vector(std::vector<RowHash>& row_hashes, duckdb::Vector& vector, size_t count) {
+    duckdb::UnifiedVectorFormat format;
+    vector.ToUnifiedFormat(count, format);
+    auto values = duckdb::UnifiedVectorFormat::GetData<duckdb::string_t>(format);
+
+    for (size_t row = 0; row < count; ++row) {
+        auto idx = format.sel->get_index(row);
+        auto cell = format.validity.RowIsValid(idx)
+            ? CanonicalCell::from_text(values[idx].GetData(), values[idx].GetSize())
+            : CanonicalCell::null();
+        combine(row_hashes[row], cell);
+    }
+}
+
+static void hash_chunk_column(std::vector<RowHash>& row_hashes, duckdb::Vector& vector, size_t count,
+                              duckdb::ClientContext& context) {
+    switch (vector.GetType().id()) {
+        case duckdb::LogicalTypeId::BOOLEAN: return hash_numeric_vector<bool>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::TINYINT: return hash_numeric_vector<int8_t>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::SMALLINT: return hash_numeric_vector<int16_t>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::INTEGER: return hash_numeric_vector<int32_t>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::BIGINT: return hash_numeric_vector<int64_t>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::UTINYINT: return hash_numeric_vector<uint8_t>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::USMALLINT: return hash_numeric_vector<uint16_t>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::UINTEGER: return hash_numeric_vector<uint32_t>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::UBIGINT: return hash_numeric_vector<uint64_t>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::FLOAT: return hash_numeric_vector<float>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::DOUBLE: return hash_numeric_vector<double>(row_hashes, vector, count);
+        case duckdb::LogicalTypeId::VARCHAR: return hash_string_vector(row_hashes, vector, count);
+        default: break;
+    }
+
+    // DECIMAL, HUGEINT, DATE, ... hash by their text form, as the expected output stores them
+    duckdb::Vector text(duckdb::LogicalType::VARCHAR, count);
+    duckdb::VectorOperations::Cast(context, vector, text, count);
+    hash_string_vector(row_hashes, text, count);
+}
+
+FingerprintSink::FingerprintSink(ResultChunkSink* downstream_sink, uint64_t limit, QueryResult* collected)
+    : downstream(downstream_sink), row_limit(limit), rows(collected), limit_exceeded(false),
+      downstream_full(false), hash_ns(0) {
+}
+
+void FingerprintSink::begin(const std::vector<std::string>& columns) {
+    fingerprint = ResultFingerprint();
+    limit_exceeded = false;
+    downstream_full = false;
+    if (rows) {
+        *rows = QueryResult();
+        rows->success = true;
+        rows->columns = columns;
+    }
+    if (downstream) downstream->begin(columns);
+}
+
+size_t FingerprintSink::append(duckdb::DataChunk& chunk, size_t count, duckdb::ClientContext& context) {
+    size_t forwarded = 0;
+    if (!downstream_full) {
+        forwarded = downstream ? downstream->append(chunk, count, context) : count;
+        downstream_full = forwarded < count;
+    }
+
+    // Too many rows to match: keep fetching only while the downstream shows them
+    if (limit_exceeded || fingerprint.row_count + count > row_limit) {
+        limit_exceeded = true;
+        return forwarded;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    row_hashes.assign(count, ROW_SEED);
+    for (size_t col = 0; col < chunk.ColumnCount(); ++col) {
+        hash_chunk_column(row_hashes, chunk.data[col], count, context);
+    }
+    accumulate(fingerprint, row_hashes);
+    fingerprint.row_count += count;
+    if (rows) {
+        append_chunk_rows(*rows, chunk, count, context);
+    }
+    hash_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+    return count;
+}
+
+} // namespace sql_practice
@@ -0,0 +1,196 @@
+#include "include/solution_runner.hpp"
+#include "include/question_loader.hpp"
+#include "include/fixture_catalog.hpp"
+#include "include/instance_pool.hpp"
+#include "include/query_scheduler.hpp"
+#include "include/result_grader.hpp"
+#include "include/config.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <optional>
+#include <stdexcept>
+
+namespace sql_practice {
+
+/**
+ * @brief Size of a result as the execute path's byte cap counts it
+ *
+ * Text cells count their length, numeric cells 8 and NULLs 4.
+ */
+static size_t result_bytes(const QueryResult& result) {
+    size_t bytes = 0;
+    for (const auto& column : result.data) {
+        for (size_t row = 0; row < column.size(); ++row) {
+            if (column.is_null(row)) bytes += 4;
+            else if (column.kind == ColumnKind::TEXT) bytes += column.strings[row].size();
+            else bytes += 8;
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @brief Run one solution on conn; fills run and, on success, derived
+ */
+static void run_solution(
+    SQLExecutor& executor,
+    DuckDBConnection* conn,
+    const Question& question,
+    SolutionRun& run,
+    std::optional<QueryResult>& derived
+) {
+    run.question_id = question.id;
+    if (question.solution.empty()) {
+        run.skipped = true;
+        run.succeeded = true;
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto finish = [&]() {
+        run.elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+    };
+
+    if (!executor.load_question_fixture(conn, question.id, question.schema,
+                                        SQLExecutor::modifies_tables(question.allowed_statements))) {
+        finish();
+        run.error = "fixture tables failed to load";
+        return;
+    }
+
+    auto parsed = executor.validate(conn, question.solution, question.allowed_statements);
+    if (!parsed.is_valid()) {
+        finish();
+        run.error = parsed.error_message;
+        return;
+    }
+
+    // No row or byte cap: the whole output becomes the expectation
+    ResultLimits limits;
+    limits.timeout_ms = std::max(Config::query_timeout_for(question.question_difficulty), 0);
+    auto result = executor.execute(conn, std::move(parsed), limits, nullptr, true);
+    finish();
+
+    if (!result.success) {
+        run.error = result.error_message;
+        return;
+    }
+    run.row_count = result.row_count;
+
+    // A correct answer is then shown truncated, though still graded on every row
+    auto caps = SQLExecutor::limits_for(question.question_difficulty);
+    run.over_response_caps = (caps.max_rows > 0 && static_cast<size_t>(result.row_count) > caps.max_rows) ||
+                             (caps.max_bytes > 0 && result_bytes(result) > caps.max_bytes);
+
+    const auto& expected = question.expected_output;
+    if (expected.success && !expected.columns.empty() &&
+        !grade_result(result, expected, question.grade_mode)) {
+        run.error = "solution output does not match the hand-written expected rows";
+        return;
+    }
+
+    run.succeeded = true;
+    derived = std::move(result);
+}
+
+std::vector<const SolutionRun*> SolutionReport::over_response_caps() const {
+    std::vector<const SolutionRun*> over;
+    for (const auto& run : runs) {
+        if (run.over_response_caps) over.push_back(&run);
+    }
+    return over;
+}
+
+SolutionReport derive_expected_outputs(QuestionLoader& loader, const FixtureCatalog& catalog,
+                                       size_t worker_count) {
+    auto start = std::chrono::steady_clock::now();
+
+    auto questions = loader.get_all_questions();
+    std::sort(questions.begin(), questions.end(), [](const auto& a, const auto& b) {
+        return a->id < b->id;
+    });
+
+    QueryScheduler scheduler(worker_count, std::max<size_t>(worker_count, 1));
+    size_t workers = std::min(scheduler.get_worker_count(), std::max<size_t>(questions.size(), 1));
+
+    // One shared instance, one connection per worker, fixtures attached as for sessions
+    auto pool = std::make_shared<DuckDBInstancePool>(1, workers);
+    pool->set_fixture_catalog(catalog.get_path(), catalog.get_version());
+
+    SolutionReport report;
+    report.runs.resize(questions.size());
+    std::vector<std::optional<QueryResult>> derived(questions.size());
+
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    auto work = [&]() {
+        SQLExecutor executor(pool);
+        auto conn = executor.create_connection();
+        while (!failed.load(std::memory_order_relaxed)) {
+            size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= questions.size()) break;
+
+            run_solution(executor, conn.get(), *questions[i], report.runs[i], derived[i]);
+            if (!report.runs[i].succeeded) failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::future<void>> running;
+    for (size_t w = 0; w < workers; ++w) {
+        auto future = scheduler.submit(work);
+        if (!future) break;
+        running.push_back(std::move(*future));
+    }
+
+    // A rejected submit leaves a worker short; the calling thread takes its
+    // place so no question is skipped. Every worker is joined before an
+    // error propagates, since they all reference this frame
+    bool run_inline = running.size() < workers;
+    std::exception_ptr error;
+    if (run_inline) {
+        try {
+            work();
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+    for (auto& future : running) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) std::rethrow_exception(error);
+    report.worker_count = running.size() + (run_inline ? 1 : 0);
+
+    // Drop runs that never started (fail-fast), keeping id order
+    report.runs.erase(std::remove_if(report.runs.begin(), report.runs.end(),
+                                     [](const SolutionRun& run) { return run.question_id.empty(); }),
+                      report.runs.end());
+    report.elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+
+    if (failed.load()) {
+        std::string message = "Reference solutions failed:";
+        for (const auto& run : report.runs) {
+            if (!run.succeeded) message += " [" + run.question_id + "] " + run.error;
+        }
+        throw std::runtime_error(message);
+    }
+
+    for (size_t i = 0; i < questions.size(); ++i) {
+        if (derived[i] && loader.set_expected_output(questions[i]->id, std::move(*derived[i]))) {
+            report.derived++;
+        }
+    }
+    return report;
+}
+
+} // namespace sql_practice
@@ -2,6 +2,16 @@
 #include "include/session_manager.hpp"
 #include "include/question_loader.hpp"
 #include "include/sql_executor.hpp"
+#include "include/result_json_writer.hpp"
+#include "include/config.hpp"
+#include "include/query_watchdog.hpp"
+#include "include/grade_cache.hpp"
+#include "include/sql_normalizer.hpp"
+#include "include/result_grader.hpp"
+#include "include/result_fingerprint.hpp"
+#include "include/engine_grader.hpp"
+#include "include/request_timing.hpp"
+#include "include/metrics.hpp"
 #include <oatpp/web/server/HttpConnectionHandler.hpp>
 #include <oatpp/web/server/HttpRouter.hpp>
 #include <oatpp/web/protocol/http/Http.hpp>
@@ -9,6 +19,8 @@
 #include <oatpp/network/tcp/server/ConnectionProvider.hpp>
 #include <nlohmann/json.hpp>
 #include <sstream>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <functional>
 #include <fstream>
@@ -21,6 +33,232 @@ namespace sql_practice {
 // Request Handlers using Oat++ 1.3.0 API
 // =============================================================================
 
+/**
+ * @brief Build the /health payload, including per-instance pool load
+ */
+static std::string build_health_json(
+    const std::shared_ptr<SessionManager>& session_manager,
+    const std::shared_ptr<QuestionLoader>& question_loader,
+    const std::shared_ptr<QueryScheduler>& query_scheduler = nullptr,
+    const std::shared_ptr<GradeCache>& grade_cache = nullptr) {
+
+    size_t active = session_manager ? session_manager->get_active_count() : 0;
+    size_t total = question_loader ? question_loader->get_count() : 0;
+    bool ready = !query_scheduler || query_scheduler->is_ready();
+
+    std::stringstream json;
+    json << "{"
+         << "\"status\":\"" << (ready ? "healthy" : "saturated") << "\","
+         << "\"ready\":" << (ready ? "true" : "false") << ","
+         << "\"active_sessions\":" << active << ","
+         << "\"total_questions\":" << total << ","
+         << "\"query_timeouts\":" << QueryWatchdog::shared().get_timeout_count();
+
+    if (session_manager) {
+        json << ",\"session_reaper\":{"
+             << "\"backlog\":" << session_manager->get_reaper_backlog() << ","
+             << "\"reaped\":" << session_manager->get_reaped_count()
+             << "}";
+    }
+
+    if (query_scheduler) {
+        json << ",\"query_queue\":{"
+             << "\"depth\":" << query_scheduler->get_queue_depth() << ","
+             << "\"capacity\":" << query_scheduler->get_queue_capacity() << ","
+             << "\"workers\":" << query_scheduler->get_worker_count() << ","
+             << "\"busy_workers\":" << query_scheduler->get_busy_workers() << ","
+             << "\"rejected\":" << query_scheduler->get_rejected_count()
+             << "}";
+    }
+
+    if (grade_cache) {
+        auto stats = grade_cache->get_stats();
+        json << ",\"grade_cache\":{"
+             << "\"entries\":" << stats.entries << ","
+             << "\"hits\":" << stats.hits << ","
+             << "\"misses\":" << stats.misses << ","
+             << "\"coalesced\":" << stats.coalesced
+             << "}";
+    }
+
+    json << ",\"request_timing\":" << RequestTimingStats::shared().to_json();
+
+    auto pool = session_manager ? session_manager->get_instance_pool() : nullptr;
+    if (pool) {
+        json << ",\"connections_per_instance\":" << pool->get_connections_per_instance()
+             << ",\"instances\":[";
+        auto stats = pool->get_load_stats();
+        for (size_t i = 0; i < stats.size(); ++i) {
+            if (i > 0) json << ",";
+            json << "{"
+                 << "\"id\":" << stats[i].instance_id << ","
+                 << "\"initialized\":" << (stats[i].initialized ? "true" : "false") << ","
+                 << "\"active_connections\":" << stats[i].active_connections << ","
+                 << "\"peak_connections\":" << stats[i].peak_connections << ","
+                 << "\"total_connections\":" << stats[i].total_connections
+                 << "}";
+        }
+        json << "]";
+    }
+
+    json << "}";
+    return json.str();
+}
+
+/**
+ * @brief Build the /metrics payload in Prometheus text format
+ */
+static std::string build_metrics_text(
+    const std::shared_ptr<SessionManager>& session_manager,
+    const std::shared_ptr<QueryScheduler>& query_scheduler,
+    const std::shared_ptr<GradeCache>& grade_cache) {
+
+    auto& metrics = Metrics::shared();
+    PrometheusWriter out;
+
+    out.family("sql_practice_http_requests_total", "counter", "HTTP responses by route and status class.");
+    metrics.for_each_route([&](const RouteMetrics& route) {
+        std::string labels = "route=\"" + PrometheusWriter::label_value(route.route) + "\",code=";
+        out.sample("sql_practice_http_requests_total", labels + "\"2xx\"", route.responses_2xx.value());
+        out.sample("sql_practice_http_requests_total", labels + "\"4xx\"", route.responses_4xx.value());
+        out.sample("sql_practice_http_requests_total", labels + "\"5xx\"", route.responses_5xx.value());
+    });
+
+    out.family("sql_practice_http_request_duration_seconds", "histogram", "HTTP request latency by route.");
+    metrics.for_each_route([&](const RouteMetrics& route) {
+        out.histogram("sql_practice_http_request_duration_seconds",
+                      "route=\"" + PrometheusWriter::label_value(route.route) + "\"", route.latency);
+    });
+
+    out.family("sql_practice_query_duration_seconds", "histogram",
+               "Student query execution including fetch and serialization.");
+    out.histogram("sql_practice_query_duration_seconds", "", metrics.query_execution);
+
+    out.family("sql_practice_queries_total", "counter", "Student queries by outcome.");
+    out.sample("sql_practice_queries_total", "outcome=\"success\"", metrics.queries_succeeded.value());
+    out.sample("sql_practice_queries_total", "outcome=\"error\"", metrics.queries_failed.value());
+    out.sample("sql_practice_queries_total", "outcome=\"timeout\"", metrics.queries_timed_out.value());
+
+    out.family("sql_practice_query_timeouts_total", "counter", "Queries interrupted by the watchdog.");
+    out.sample("sql_practice_query_timeouts_total", "", QueryWatchdog::shared().get_timeout_count());
+
+    if (session_manager) {
+        out.family("sql_practice_sessions_active", "gauge", "Sessions currently held.");
+        out.sample("sql_practice_sessions_active", "", static_cast<uint64_t>(session_manager->get_active_count()));
+    }
+    out.family("sql_practice_sessions_created_total", "counter", "Sessions created by /api/login.");
+    out.sample("sql_practice_sessions_created_total", "", metrics.sessions_created.value());
+    out.family("sql_practice_sessions_expired_total", "counter", "Sessions removed after the idle timeout.");
+    out.sample("sql_practice_sessions_expired_total", "", metrics.sessions_expired.value());
+    out.family("sql_practice_sessions_terminated_total", "counter", "Sessions removed explicitly.");
+    out.sample("sql_practice_sessions_terminated_total", "", metrics.sessions_terminated.value());
+    out.family("sql_practice_session_cleanup_duration_seconds", "histogram", "Duration of expired-session sweeps.");
+    out.histogram("sql_practice_session_cleanup_duration_seconds", "", metrics.session_cleanup);
+    out.family("sql_practice_session_teardown_duration_seconds", "histogram",
+               "Duration of one reaper batch of session teardowns.");
+    out.histogram("sql_practice_session_teardown_duration_seconds", "", metrics.session_teardown);
+
+    if (session_manager) {
+        out.family("sql_practice_session_reaper_backlog", "gauge", "Removed sessions waiting to be destroyed.");
+        out.sample("sql_practice_session_reaper_backlog", "",
+                   static_cast<uint64_t>(session_manager->get_reaper_backlog()));
+        out.family("sql_practice_sessions_reaped_total", "counter", "Sessions destroyed by the reaper.");
+        out.sample("sql_practice_sessions_reaped_total", "", session_manager->get_reaped_count());
+    }
+
+    if (query_scheduler) {
+        out.family("sql_practice_query_queue_depth", "gauge", "Queries waiting for a worker.");
+        out.sample("sql_practice_query_queue_depth", "", static_cast<uint64_t>(query_scheduler->get_queue_depth()));
+        out.family("sql_practice_query_queue_rejected_total", "counter", "Queries refused with 503.");
+        out.sample("sql_practice_query_queue_rejected_total", "", query_scheduler->get_rejected_count());
+        out.family("sql_practice_query_workers", "gauge", "Query worker threads by state.");
+        size_t busy = query_scheduler->get_busy_workers();
+        out.sample("sql_practice_query_workers", "state=\"busy\"", static_cast<uint64_t>(busy));
+        out.sample("sql_practice_query_workers", "state=\"idle\"",
+                   static_cast<uint64_t>(query_scheduler->get_worker_count() - std::min(busy, query_scheduler->get_worker_count())));
+    }
+
+    if (grade_cache) {
+        auto stats = grade_cache->get_stats();
+        out.family("sql_practice_grade_cache_lookups_total", "counter", "Grade cache lookups by result.");
+        out.sample("sql_practice_grade_cache_lookups_total", "result=\"hit\"", stats.hits);
+        out.sample("sql_practice_grade_cache_lookups_total", "result=\"miss\"", stats.misses);
+        out.sample("sql_practice_grade_cache_lookups_total", "result=\"coalesced\"", stats.coalesced);
+    }
+
+    out.family("sql_practice_process_threads", "gauge", "Threads in this process.");
+    out.sample("sql_practice_process_threads", "", static_cast<uint64_t>(process_thread_count()));
+
+    auto pool = session_manager ? session_manager->get_instance_pool() : nullptr;
+    if (pool) {
+        auto stats = pool->get_load_stats();
+        out.family("sql_practice_duckdb_memory_used_bytes", "gauge", "Buffer manager memory per DuckDB instance.");
+        for (const auto& instance : stats) {
+            if (!instance.initialized) continue;
+            out.sample("sql_practice_duckdb_memory_used_bytes",
+                       "instance=\"" + std::to_string(instance.instance_id) + "\"", instance.memory_used_bytes);
+        }
+        out.family("sql_practice_duckdb_memory_limit_bytes", "gauge", "Buffer manager limit per DuckDB instance.");
+        for (const auto& instance : stats) {
+            if (!instance.initialized) continue;
+            out.sample("sql_practice_duckdb_memory_limit_bytes",
+                       "instance=\"" + std::to_string(instance.instance_id) + "\"", instance.memory_limit_bytes);
+        }
+        out.family("sql_practice_duckdb_threads", "gauge", "Worker threads per DuckDB instance.");
+        for (const auto& instance : stats) {
+            if (!instance.initialized) continue;
+            out.sample("sql_practice_duckdb_threads",
+                       "instance=\"" + std::to_string(instance.instance_id) + "\"",
+                       static_cast<uint64_t>(instance.threads));
+        }
+        out.family("sql_practice_duckdb_connections", "gauge", "Sessions leased to each DuckDB instance.");
+        for (const auto& instance : stats) {
+            out.sample("sql_practice_duckdb_connections",
+                       "instance=\"" + std::to_string(instance.instance_id) + "\"",
+                       static_cast<uint64_t>(instance.active_connections));
+        }
+    }
+
+    return out.release();
+}
+
+/**
+ * @brief Times every request of a route and counts its responses by status class
+ */
+class InstrumentedHandler : public oatpp::web::server::HttpRequestHandler {
+private:
+    std::shared_ptr<oatpp::web::server::HttpRequestHandler> handler;
+    RouteMetrics* metrics;
+
+public:
+    InstrumentedHandler(const std::string& route,
+                        std::shared_ptr<oatpp::web::server::HttpRequestHandler> inner)
+        : handler(std::move(inner)), metrics(Metrics::shared().route(route)) {}
+
+    std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> handle(
+        const std::shared_ptr<oatpp::web::protocol::http::incoming::Request>& request) override {
+
+        auto started = std::chrono::steady_clock::now();
+        auto response = handler->handle(request);
+        metrics->record(response ? response->getStatus().code : 500,
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - started
+                        ).count());
+        return response;
+    }
+};
+
+/**
+ * @brief Count a student query and add its duration to the execution histogram
+ */
+static void record_query(const QueryResult& result) {
+    auto& metrics = Metrics::shared();
+    metrics.query_execution.record(result.execute_us + result.fetch_us + result.sink_us);
+    if (result.timed_out) metrics.queries_timed_out.add();
+    else if (result.success) metrics.queries_succeeded.add();
+    else metrics.queries_failed.add();
+}
+
 /**
  * @brief Custom RequestHandler for health endpoint
  */
@@ -28,26 +266,53 @@ class HealthHandler : public oatpp::web::server::HttpRequestHandler {
 private:
     std::shared_ptr<SessionManager> session_manager;
     std::shared_ptr<QuestionLoader> question_loader;
+    std::shared_ptr<QueryScheduler> query_scheduler;
+    std::shared_ptr<GradeCache> grade_cache;
 public:
     HealthHandler(std::shared_ptr<SessionManager> sm,
-                 std::shared_ptr<QuestionLoader> ql)
-        : session_manager(sm), question_loader(ql) {}
+                 std::shared_ptr<QuestionLoader> ql,
+                 std::shared_ptr<QueryScheduler> qs,
+                 std::shared_ptr<GradeCache> gc)
+        : session_manager(sm), question_loader(ql), query_scheduler(qs), grade_cache(gc) {}
 
     std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> handle(
         const std::shared_ptr<oatpp::web::protocol::http::incoming::Request>& request) override {
 
-        size_t active = session_manager ? session_manager->get_active_count() : 0;
-        size_t total = question_loader ? question_loader->get_count() : 0;
+        // 503 while the query queue is saturated so load balancers route around us
+        auto body = oatpp::String(build_health_json(session_manager, question_loader,
+                                                     query_scheduler, grade_cache));
+        bool ready = query_scheduler->is_ready();
+        return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
+            ready ? oatpp::web::protocol::http::Status::CODE_200
+                  : oatpp::web::protocol::http::Status::CODE_503,
+            body
+        );
+    }
+};
 
-        char buffer[256];
-        snprintf(buffer, sizeof(buffer),
-                 "{\"status\":\"healthy\",\"active_sessions\":%zu,\"total_questions\":%zu}",
-                 active, total);
+/**
+ * @brief Custom RequestHandler for Prometheus metrics endpoint
+ */
+class MetricsHandler : public oatpp::web::server::HttpRequestHandler {
+private:
+    std::shared_ptr<SessionManager> session_manager;
+    std::shared_ptr<QueryScheduler> query_scheduler;
+    std::shared_ptr<GradeCache> grade_cache;
+public:
+    MetricsHandler(std::shared_ptr<SessionManager> sm,
+                   std::shared_ptr<QueryScheduler> qs,
+                   std::shared_ptr<GradeCache> gc)
+        : session_manager(sm), query_scheduler(qs), grade_cache(gc) {}
 
-        auto body = oatpp::String(buffer);
-        return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
-            oatpp::web::protocol::http::Status::CODE_200, body
+    std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> handle(
+        const std::shared_ptr<oatpp::web::protocol::http::incoming::Request>&) override {
+
+        auto response = oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
+            oatpp::web::protocol::http::Status::CODE_200,
+            oatpp::String(build_metrics_text(session_manager, query_scheduler, grade_cache))
         );
+        response->putHeader("Content-Type", "text/plain; version=0.0.4");
+        return response;
     }
 };
 
@@ -112,7 +377,10 @@ public:
             );
 
         } catch (const std::exception& e) {
-            auto dto = oatpp::String(std::string("{\"is_correct\":false,\"error\":\"") + e.what() + "\"}");
+            std::string body = "{\"is_correct\":false,\"error\":";
+            ResultJsonWriter::append_escaped(body, e.what(), std::strlen(e.what()));
+            body += "}";
+            auto dto = oatpp::String(body);
             return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
                 oatpp::web::protocol::http::Status::CODE_500, dto
             );
@@ -120,6 +388,37 @@ public:
     }
 };
 
+/**
+ * @brief Look up a question and switch the session's connection to its tables
+ *
+ * The caller holds session->query_mutex. question is left null for an
+ * empty or unknown question_id, and the connection stays on its current
+ * schema. Returns false if the question's tables could not be loaded; the
+ * connection then still points at the previous question's tables, so the
+ * caller must not run or grade the query.
+ */
+static bool enter_question(
+    const std::shared_ptr<UserSession>& session,
+    const QuestionLoader& loader,
+    SQLExecutor& executor,
+    const std::string& question_id,
+    std::shared_ptr<const Question>& question) {
+
+    if (!question_id.empty()) {
+        question = loader.get_question_by_id(question_id);
+    }
+
+    // Switch to the question's schema if different from current
+    if (question && session->current_question_id != question_id) {
+        bool initialized = executor.load_question_fixture(
+            session->db_conn.get(), question_id, question->schema,
+            SQLExecutor::modifies_tables(question->allowed_statements));
+        if (!initialized) return false;
+        session->current_question_id = question_id;
+    }
+    return true;
+}
+
 /**
  * @brief Custom RequestHandler for execute endpoint
  */
@@ -127,34 +426,50 @@ class ExecuteHandler : public oatpp::web::server::HttpRequestHandler {
 private:
     std::shared_ptr<SessionManager> session_manager;
     std::shared_ptr<QuestionLoader> question_loader;
+    std::shared_ptr<QueryScheduler> query_scheduler;
+    std::shared_ptr<GradeCache> grade_cache;
+    std::shared_ptr<EngineGrader> engine_grader;  // Null when in-engine grading is off
 
 public:
     ExecuteHandler(std::shared_ptr<SessionManager> sm,
-                   std::shared_ptr<QuestionLoader> ql)
-        : session_manager(sm), question_loader(ql) {}
+                   std::shared_ptr<QuestionLoader> ql,
+                   std::shared_ptr<QueryScheduler> qs,
+                   std::shared_ptr<GradeCache> gc,
+                   std::shared_ptr<EngineGrader> eg)
+        : session_manager(sm), question_loader(ql), query_scheduler(qs), grade_cache(gc), engine_grader(eg) {}
 
     std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> handle(
         const std::shared_ptr<oatpp::web::protocol::http::incoming::Request>& request) override {
 
+        using Status = oatpp::web::protocol::http::Status;
+        auto started = std::chrono::steady_clock::now();
+        int64_t cpu_started = thread_cpu_us();
+        RequestTiming timing;
+
+        // Every response, rejected ones included, carries Server-Timing and
+        // counts in the /health aggregates; stop running phase timers first
+        auto reject = [&](const Status& status, const oatpp::String& body) {
+            return finish(oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(status, body),
+                          timing, started, cpu_started);
+        };
+
         try {
             // Read request body
+            PhaseTimer body_timer(&timing, RequestPhase::BODY_READ);
             auto body_str = request->readBodyToString();
+            body_timer.stop();
             if (!body_str || body_str->empty()) {
-                auto dto = oatpp::String("{\"is_correct\":false,\"error\":\"Request body is required\"}");
-                return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
-                    oatpp::web::protocol::http::Status::CODE_400, dto
-                );
+                return reject(Status::CODE_400, "{\"is_correct\":false,\"error\":\"Request body is required\"}");
             }
 
             // Parse JSON using nlohmann/json
+            PhaseTimer parse_timer(&timing, RequestPhase::JSON_PARSE);
             json request_json;
             try {
                 request_json = json::parse(body_str->c_str());
             } catch (const json::parse_error& e) {
-                auto dto = oatpp::String("{\"is_correct\":false,\"error\":\"Invalid JSON\"}");
-                return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
-                    oatpp::web::protocol::http::Status::CODE_400, dto
-                );
+                parse_timer.stop();
+                return reject(Status::CODE_400, "{\"is_correct\":false,\"error\":\"Invalid JSON\"}");
             }
 
             // Extract fields
@@ -162,27 +477,26 @@ public:
             std::string user_sql = request_json.value("user_sql", "");
             std::string question_id = request_json.value("question_id", "");
             std::string question_slug = request_json.value("question_slug", "");
+            parse_timer.stop();
 
             // Validate session token
             if (session_token.empty()) {
-                auto dto = oatpp::String("{\"is_correct\":false,\"error\":\"session_token is required\"}");
-                return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
-                    oatpp::web::protocol::http::Status::CODE_400, dto
-                );
+                return reject(Status::CODE_400, "{\"is_correct\":false,\"error\":\"session_token is required\"}");
             }
 
-            // Get session
-            auto session = session_manager->get_session(session_token);
+            // Get session; the token is decoded once here and malformed ones never reach the table
+            PhaseTimer session_timer(&timing, RequestPhase::SESSION_LOOKUP);
+            auto token = SessionToken::parse(session_token);
+            auto session = token ? session_manager->get_session(*token) : nullptr;
             if (!session || session->is_expired()) {
-                auto dto = oatpp::String("{\"is_correct\":false,\"error\":\"Invalid or expired session\"}");
-                return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
-                    oatpp::web::protocol::http::Status::CODE_401, dto
-                );
+                session_timer.stop();
+                return reject(Status::CODE_401, "{\"is_correct\":false,\"error\":\"Invalid or expired session\"}");
             }
 
             // Update activity
             session->update_activity();
             session->query_count++;
+            session_timer.stop();
 
             // Convert question_slug to question_id if needed
             if (!question_slug.empty()) {
@@ -195,130 +509,412 @@ public:
             }
 
             if (user_sql.empty()) {
-                auto dto = oatpp::String("{\"is_correct\":false,\"error\":\"user_sql is required\"}");
-                return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
-                    oatpp::web::protocol::http::Status::CODE_400, dto
-                );
+                return reject(Status::CODE_400, "{\"is_correct\":false,\"error\":\"user_sql is required\"}");
             }
 
-            // Initialize schema if question_id is provided and different from current
-            SQLExecutor executor;
-            if (!question_id.empty() && session->current_question_id != question_id) {
-                auto question = question_loader->get_question_by_id(question_id);
-                if (question) {
-                    bool initialized = executor.initialize_schema(session->db_conn.get(), question->schema);
-                    if (initialized) {
-                        session->current_question_id = question_id;
-                    }
+            // A session runs one query at a time (its connection's search_path
+            // and question schema LRU are per-connection state). That wait
+            // happens here, so a backed-up session never ties up a worker, and
+            // it covers the cache lookup so schema_modified cannot change under it
+            auto submitted = std::chrono::steady_clock::now();
+            std::lock_guard<std::mutex> query_lock(session->query_mutex);
+
+            // Run on a query worker; refuse with 503 when the queue is full
+            auto execute = [&]() -> GradeResponse {
+                RequestTiming* request_timing = &timing;
+                auto pending = query_scheduler->submit([this, session, question_id, user_sql,
+                                                        request_timing, submitted]() {
+                    return run_query(session, question_id, user_sql, request_timing, submitted);
+                });
+                if (!pending) {
+                    return GradeResponse{503, "{\"is_correct\":false,\"error\":\"Server is busy, please retry\"}"};
                 }
+                return pending->get();
+            };
+
+            // run_query marks sessions that ran DDL/DML and decides, after
+            // executing, whether its response may be stored
+            auto normalized = normalize_sql(user_sql);
+            bool use_cache = !question_id.empty() && normalized.read_only && normalized.deterministic &&
+                             !session->schema_modified;
+            if (!use_cache) {
+                return finish(to_http_response(execute(), false), timing, started, cpu_started);
             }
 
-            // Execute SQL
-            auto result = executor.execute(session->db_conn.get(), user_sql);
+            // Identical submissions share one execution and its stored grade
+            GradeKey key{question_id, session_manager->get_instance_pool()->get_fixture_version(),
+                         normalized.hash, std::move(normalized.text)};
+            bool cached = false;
+            auto graded = grade_cache->get_or_compute(key, execute, cached);
+            return finish(to_http_response(*graded, cached), timing, started, cpu_started);
 
-            if (!result.success) {
-                auto dto = oatpp::String("{\"is_correct\":false,\"error\":\"" + result.error_message + "\"}");
-                return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
-                    oatpp::web::protocol::http::Status::CODE_400, dto
-                );
-            }
+        } catch (const std::exception& e) {
+            std::string body = "{\"is_correct\":false,\"error\":";
+            ResultJsonWriter::append_escaped(body, e.what(), std::strlen(e.what()));
+            body += "}";
+            return reject(Status::CODE_500, oatpp::String(body));
+        }
+    }
 
-            // Compare with expected result if question_id is provided
-            bool is_correct = true;
-            if (!question_id.empty()) {
-                auto question = question_loader->get_question_by_id(question_id);
-                if (question && question->expected_output.success) {
-                    // Compare column names
-                    if (result.columns != question->expected_output.columns) {
-                        is_correct = false;
-                    }
-                    // Compare row count
-                    else if (result.rows.size() != question->expected_output.rows.size()) {
-                        is_correct = false;
-                    }
-                    // Compare actual data
-                    else {
-                        for (const auto& expected_row : question->expected_output.rows) {
-                            bool row_found = false;
-                            for (const auto& actual_row : result.rows) {
-                                if (actual_row == expected_row) {
-                                    row_found = true;
-                                    break;
-                                }
-                            }
-                            if (!row_found) {
-                                is_correct = false;
-                                break;
-                            }
-                        }
-                    }
+private:
+    /**
+     * @brief Stamp the request's phase timings on the response and record them
+     *
+     * Phases that did not run (a cache hit never queues or executes, a
+     * rejected request stops early) stay 0.
+     */
+    static std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> finish(
+        std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> response,
+        RequestTiming& timing,
+        std::chrono::steady_clock::time_point started,
+        int64_t cpu_started) {
+
+        timing.cpu_us += thread_cpu_us() - cpu_started;
+        timing.total_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started
+        ).count();
+        response->putHeader("Server-Timing", timing.server_timing());
+        RequestTimingStats::shared().record(timing);
+        return response;
+    }
+
+    /**
+     * @brief Build the HTTP response for a (possibly shared) graded response
+     */
+    static std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> to_http_response(
+        const GradeResponse& graded, bool cached) {
+
+        using Status = oatpp::web::protocol::http::Status;
+        Status status = Status::CODE_200;
+        switch (graded.status_code) {
+            case 400: status = Status::CODE_400; break;
+            case 408: status = Status::CODE_408; break;
+            case 503: status = Status::CODE_503; break;
+            case 500: status = Status::CODE_500; break;
+            default: break;
+        }
+
+        // Shares the body's buffer, whether it is cached or was just built
+        auto response = oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
+            status, graded.body
+        );
+        if (graded.status_code == 503) {
+            response->putHeader("Retry-After", "1");
+        }
+        if (cached) {
+            response->putHeader("X-Grade-Cache", "hit");
+        }
+        return response;
+    }
+
+    /**
+     * @brief Execute and grade a query; runs on a QueryScheduler worker
+     *
+     * The caller holds session->query_mutex. Phase timings go to timing,
+     * which the submitting handler keeps alive until the response is
+     * returned; submitted marks when the handler started waiting for the
+     * session, so QUEUE_WAIT covers both the session and the worker queue.
+     */
+    GradeResponse run_query(
+        const std::shared_ptr<UserSession>& session,
+        const std::string& question_id,
+        const std::string& user_sql,
+        RequestTiming* timing,
+        std::chrono::steady_clock::time_point submitted) {
+
+        int64_t cpu_started = thread_cpu_us();
+        struct CpuCharge {
+            RequestTiming* timing;
+            int64_t started;
+            ~CpuCharge() { timing->cpu_us += thread_cpu_us() - started; }
+        } cpu_charge{timing, cpu_started};
+
+        timing->add(RequestPhase::QUEUE_WAIT, std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - submitted
+        ).count());
+
+        SQLExecutor executor;
+        PhaseTimer schema_timer(timing, RequestPhase::SCHEMA_INIT);
+        std::shared_ptr<const Question> question;
+        bool entered = enter_question(session, *question_loader, executor, question_id, question);
+        schema_timer.stop();
+        if (!entered) {
+            return error_response(500, "Failed to load the question's tables", false);
+        }
+
+        // Parse once and check statement types against the question's allow-list;
+        // the parsed statements are executed as-is below
+        static const std::vector<std::string> select_only;
+        PhaseTimer validate_timer(timing, RequestPhase::VALIDATION);
+        auto parsed = executor.validate(session->db_conn.get(), user_sql,
+                                        question ? question->allowed_statements : select_only);
+        validate_timer.stop();
+        if (!parsed.is_valid()) {
+            return error_response(400, parsed.error_message, false);
+        }
+
+        // DDL/DML makes the session's tables its own from here on; only a
+        // SELECT on tables nobody modified can be graded for everyone
+        bool read_only = parsed.read_only();
+        bool fixtures_unmodified = !session->schema_modified;
+        if (!read_only) {
+            session->schema_modified = true;
+        }
+
+        // Graded answers stream through a FingerprintSink, which keeps hashing
+        // once the response is full, so every answer is graded on all of its
+        // rows. Only ordered questions also collect rows, for grade_result
+        bool grade = question && question->expected_output.success;
+        bool ordered = grade && question->grade_mode == GradeMode::ORDERED;
+
+        // Large unordered questions are graded inside DuckDB by the
+        // EngineGrader instead: the fetch stops at the response caps and no
+        // row is hashed here. That needs a single SELECT on the fixture
+        // tables as every session starts with them
+        std::string select_sql = grade && !ordered && engine_grader ? parsed.select_sql() : std::string();
+        bool in_engine = !select_sql.empty() && fixtures_unmodified && Config::engine_grade_min_rows > 0 &&
+                         question->expected_output.row_count >= Config::engine_grade_min_rows &&
+                         session->db_conn->has_fixture_catalog() && engine_grader->covers(question->id);
+        bool fingerprint = grade && !in_engine;
+
+        // Execute SQL, serializing chunks straight into the response. The
+        // row and byte caps bound the response only: a fingerprinted fetch
+        // goes on until the FingerprintSink has seen more rows than expected
+        auto limits = SQLExecutor::limits_for(question ? question->question_difficulty : "");
+        ResultJsonWriter writer(limits.max_bytes, limits.max_rows);
+        QueryResult graded_rows;
+        FingerprintSink grading(&writer, grade ? static_cast<uint64_t>(question->expected_output.row_count) : 0,
+                                ordered ? &graded_rows : nullptr);
+        ResultChunkSink* sink = fingerprint ? static_cast<ResultChunkSink*>(&grading) : &writer;
+        ResultLimits response_limits = limits;
+        if (fingerprint) limits.max_rows = 0;
+
+        auto result = executor.execute(session->db_conn.get(), std::move(parsed), limits, sink, false);
+        record_query(result);
+        bool truncated = result.truncated || grading.downstream_truncated();
+
+        // The sink's time splits into fingerprinting (grading) and JSON writing
+        timing->add(RequestPhase::EXECUTION, result.execute_us);
+        timing->add(RequestPhase::FETCH, result.fetch_us);
+        timing->add(RequestPhase::GRADING, grading.get_hash_us());
+        timing->add(RequestPhase::SERIALIZATION,
+                    std::max<int64_t>(result.sink_us - grading.get_hash_us(), 0));
+
+        if (result.timed_out) {
+            return error_response(408, result.error_message, true);
+        }
+
+        if (!result.success) {
+            return error_response(400, result.error_message, false);
+        }
+
+        // Compare with expected result if question_id is provided
+        PhaseTimer grade_timer(timing, RequestPhase::GRADING);
+        bool is_correct = true;
+        if (grade && result.columns != question->expected_output.columns) {
+            is_correct = false;
+        } else if (in_engine) {
+            auto verdict = engine_grader->grade(select_sql, *question, limits.timeout_ms);
+            if (verdict.timed_out) {
+                return error_response(408, verdict.error_message, true);
+            }
+            if (verdict.success) {
+                is_correct = verdict.is_correct;
+            } else {
+                // The grading instance could not run it (a name only the
+                // session resolves, ...): fingerprint a second run here
+                FingerprintSink rerun_grading(nullptr, static_cast<uint64_t>(question->expected_output.row_count));
+                ResultLimits rerun_limits = response_limits;
+                rerun_limits.max_rows = 0;
+                auto rerun = executor.execute(session->db_conn.get(), user_sql, rerun_limits, &rerun_grading, false);
+                if (rerun.timed_out) {
+                    return error_response(408, rerun.error_message, true);
                 }
+                is_correct = rerun.success && rerun_grading.matches(question->expected_fingerprint);
             }
+        } else if (grade && grading.exceeded_row_limit()) {
+            // More rows than expected: wrong without looking at values. A
+            // response cut short by its caps is still graded on every row
+            is_correct = false;
+        } else if (grade && !grading.matches(question->expected_fingerprint)) {
+            // Same row count and 128-bit fingerprint is the unordered verdict
+            is_correct = false;
+        } else if (ordered) {
+            // The fingerprint ignores order; check it on the collected rows
+            is_correct = grade_result(graded_rows, question->expected_output, question->grade_mode);
+        }
 
-            // Build response with columns and rows
-            std::stringstream json;
-            json << "{"
-                 << "\"is_correct\":" << (is_correct ? "true" : "false") << ","
-                 << "\"execution_time_ms\":" << result.execution_time_ms << ","
-                 << "\"columns\":[";
-
-            // Add columns
-            for (size_t i = 0; i < result.columns.size(); ++i) {
-                if (i > 0) json << ",";
-                json << "\"" << result.columns[i] << "\"";
+        grade_timer.stop();
+
+        // Finish the response; the buffer moves into the oatpp::String
+        PhaseTimer serialize_timer(timing, RequestPhase::SERIALIZATION);
+        writer.write_field("is_correct", is_correct);
+        writer.write_field("truncated", truncated);
+        writer.write_field("execution_time_ms", static_cast<int64_t>(result.execution_time_ms));
+
+        return GradeResponse{200, oatpp::String(writer.release()), grade && read_only && fixtures_unmodified};
+    }
+
+    /**
+     * @brief Failed /api/execute response carrying a DuckDB error message
+     */
+    static GradeResponse error_response(int status_code, const std::string& message, bool timed_out) {
+        std::string body = timed_out ? "{\"is_correct\":false,\"timed_out\":true,\"error\":"
+                                     : "{\"is_correct\":false,\"error\":";
+        ResultJsonWriter::append_escaped(body, message.data(), message.size());
+        body += "}";
+        return GradeResponse{status_code, oatpp::String(std::move(body))};
+    }
+};
+
+/**
+ * @brief Custom RequestHandler for explain endpoint
+ *
+ * Runs the student's query like ExecuteHandler (same session, question
+ * schema, allow-list and query workers) with DuckDB's profiler enabled,
+ * and returns its JSON operator tree instead of the rows.
+ */
+class ExplainHandler : public oatpp::web::server::HttpRequestHandler {
+private:
+    std::shared_ptr<SessionManager> session_manager;
+    std::shared_ptr<QuestionLoader> question_loader;
+    std::shared_ptr<QueryScheduler> query_scheduler;
+
+public:
+    ExplainHandler(std::shared_ptr<SessionManager> sm,
+                   std::shared_ptr<QuestionLoader> ql,
+                   std::shared_ptr<QueryScheduler> qs)
+        : session_manager(sm), question_loader(ql), query_scheduler(qs) {}
+
+    std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> handle(
+        const std::shared_ptr<oatpp::web::protocol::http::incoming::Request>& request) override {
+
+        using Status = oatpp::web::protocol::http::Status;
+        using oatpp::web::protocol::http::outgoing::ResponseFactory;
+
+        try {
+            auto body_str = request->readBodyToString();
+            if (!body_str || body_str->empty()) {
+                return ResponseFactory::createResponse(
+                    Status::CODE_400, oatpp::String("{\"error\":\"Request body is required\"}"));
             }
 
-            json << "],"
-                 << "\"rows\":[";
+            json request_json;
+            try {
+                request_json = json::parse(body_str->c_str());
+            } catch (const json::parse_error& e) {
+                return ResponseFactory::createResponse(
+                    Status::CODE_400, oatpp::String("{\"error\":\"Invalid JSON\"}"));
+            }
 
-            // Add rows
-            for (size_t i = 0; i < result.rows.size(); ++i) {
-                if (i > 0) json << ",";
-                json << "{";
-                const auto& row = result.rows[i];
-                bool first = true;
-                for (const auto& col : result.columns) {
-                    if (!first) json << ",";
-                    json << "\"" << col << "\":";
-
-                    auto it = row.find(col);
-                    if (it != row.end()) {
-                        // Escape the value for JSON
-                        std::string val = it->second;
-                        // Simple JSON escaping
-                        std::string escaped;
-                        for (char c : val) {
-                            if (c == '"') escaped += "\\\"";
-                            else if (c == '\\') escaped += "\\\\";
-                            else if (c == '\n') escaped += "\\n";
-                            else if (c == '\r') escaped += "\\r";
-                            else if (c == '\t') escaped += "\\t";
-                            else escaped += c;
-                        }
-                        json << "\"" << escaped << "\"";
-                    } else {
-                        json << "null";
-                    }
-                    first = false;
+            std::string session_token = request_json.value("session_token", "");
+            std::string user_sql = request_json.value("user_sql", "");
+            std::string question_id = request_json.value("question_id", "");
+            std::string question_slug = request_json.value("question_slug", "");
+
+            if (session_token.empty()) {
+                return ResponseFactory::createResponse(
+                    Status::CODE_400, oatpp::String("{\"error\":\"session_token is required\"}"));
+            }
+
+            auto token = SessionToken::parse(session_token);
+            auto session = token ? session_manager->get_session(*token) : nullptr;
+            if (!session || session->is_expired()) {
+                return ResponseFactory::createResponse(
+                    Status::CODE_401, oatpp::String("{\"error\":\"Invalid or expired session\"}"));
+            }
+            session->update_activity();
+
+            if (!question_slug.empty()) {
+                auto q = question_loader->get_question_by_slug(question_slug);
+                if (q) {
+                    question_id = q->id;
                 }
-                json << "}";
             }
 
-            json << "],"
-                 << "\"execution_time_ms\":" << result.execution_time_ms
-                 << "}";
+            if (user_sql.empty()) {
+                return ResponseFactory::createResponse(
+                    Status::CODE_400, oatpp::String("{\"error\":\"user_sql is required\"}"));
+            }
 
-            auto dto = oatpp::String(json.str());
-            return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
-                oatpp::web::protocol::http::Status::CODE_200, dto
-            );
+            // Same worker pool, backpressure and per-session ordering as /api/execute
+            std::lock_guard<std::mutex> query_lock(session->query_mutex);
+            auto pending = query_scheduler->submit([this, session, question_id, user_sql]() {
+                return run_explain(session, question_id, user_sql);
+            });
+            if (!pending) {
+                auto response = ResponseFactory::createResponse(
+                    Status::CODE_503, oatpp::String("{\"error\":\"Server is busy, please retry\"}"));
+                response->putHeader("Retry-After", "1");
+                return response;
+            }
+
+            auto explained = pending->get();
+            Status status = Status::CODE_200;
+            if (explained.status_code == 400) status = Status::CODE_400;
+            else if (explained.status_code == 408) status = Status::CODE_408;
+            else if (explained.status_code == 500) status = Status::CODE_500;
+            return ResponseFactory::createResponse(status, explained.body);
 
         } catch (const std::exception& e) {
-            auto dto = oatpp::String(std::string("{\"is_correct\":false,\"error\":\"") + e.what() + "\"}");
-            return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
-                oatpp::web::protocol::http::Status::CODE_500, dto
-            );
+            std::string body = "{\"error\":";
+            ResultJsonWriter::append_escaped(body, e.what(), std::strlen(e.what()));
+            body += "}";
+            return ResponseFactory::createResponse(Status::CODE_500, oatpp::String(body));
+        }
+    }
+
+private:
+    /**
+     * @brief Profile a query; runs on a QueryScheduler worker
+     *
+     * The caller holds session->query_mutex.
+     */
+    GradeResponse run_explain(
+        const std::shared_ptr<UserSession>& session,
+        const std::string& question_id,
+        const std::string& user_sql) {
+
+        SQLExecutor executor;
+        std::shared_ptr<const Question> question;
+        if (!enter_question(session, *question_loader, executor, question_id, question)) {
+            return GradeResponse{500, "{\"error\":\"Failed to load the question's tables\"}"};
+        }
+
+        static const std::vector<std::string> select_only;
+        auto parsed = executor.validate(session->db_conn.get(), user_sql,
+                                        question ? question->allowed_statements : select_only);
+        if (!parsed.is_valid()) {
+            std::string body = "{\"error\":";
+            ResultJsonWriter::append_escaped(body, parsed.error_message.data(), parsed.error_message.size());
+            body += "}";
+            return GradeResponse{400, oatpp::String(std::move(body))};
+        }
+
+        std::string profile;
+        auto limits = SQLExecutor::limits_for(question ? question->question_difficulty : "");
+        auto result = executor.explain_analyze(session->db_conn.get(), std::move(parsed), limits, profile);
+        record_query(result);
+
+        if (!result.success) {
+            std::string body = result.timed_out ? "{\"timed_out\":true,\"error\":" : "{\"error\":";
+            ResultJsonWriter::append_escaped(body, result.error_message.data(), result.error_message.size());
+            body += "}";
+            return GradeResponse{result.timed_out ? 408 : 400, oatpp::String(std::move(body))};
+        }
+
+        // DuckDB's profile is already JSON and is embedded as-is
+        std::string body = "{\"columns\":[";
+        for (size_t i = 0; i < result.columns.size(); ++i) {
+            if (i > 0) body += ',';
+            ResultJsonWriter::append_escaped(body, result.columns[i].data(), result.columns[i].size());
         }
+        body += "],\"row_count\":" + std::to_string(result.row_count);
+        body += ",\"execution_time_ms\":" + std::to_string(result.execution_time_ms);
+        body += ",\"profile\":";
+        body += profile.empty() ? "null" : profile;
+        body += "}";
+        return GradeResponse{200, oatpp::String(std::move(body))};
     }
 };
 
@@ -367,7 +963,7 @@ public:
         json << "[";
         for (size_t i = 0; i < questions.size(); ++i) {
             if (i > 0) json << ",";
-            const auto& q = questions[i];
+            const auto& q = *questions[i];
             json << "{"
                  << "\"id\":\"" << q.id << "\","
                  << "\"title\":\"" << q.title << "\","
@@ -547,33 +1143,55 @@ public:
 
 HTTPServer::HTTPServer(
     std::shared_ptr<SessionManager> sm,
-    std::shared_ptr<QuestionLoader> ql
-) : session_manager(sm), question_loader(ql) {
+    std::shared_ptr<QuestionLoader> ql,
+    std::shared_ptr<EngineGrader> eg
+) : session_manager(sm), question_loader(ql), engine_grader(eg) {
+    query_scheduler = std::make_shared<QueryScheduler>(
+        static_cast<size_t>(std::max(Config::query_workers, 0)),
+        static_cast<size_t>(std::max(Config::query_queue_capacity, 1))
+    );
+    grade_cache = std::make_shared<GradeCache>(static_cast<size_t>(std::max(Config::grade_cache_size, 0)));
     router = oatpp::web::server::HttpRouter::createShared();
     setupRoutes();
 }
 
 void HTTPServer::setupRoutes() {
+    auto route = [this](const char* method, const char* path, const char* name,
+                        std::shared_ptr<oatpp::web::server::HttpRequestHandler> handler) {
+        router->route(method, path, std::make_shared<InstrumentedHandler>(name, std::move(handler)));
+    };
+
     // Serve index.html for root path
-    router->route("GET", "/", std::make_shared<StaticFileHandler>("/home/vagrant/project/cplusplus/web"));
+    route("GET", "/", "/", std::make_shared<StaticFileHandler>("/home/vagrant/project/cplusplus/web"));
 
     // Health check
-    router->route("GET", "/health", std::make_shared<HealthHandler>(session_manager, question_loader));
+    route("GET", "/health", "/health", std::make_shared<HealthHandler>(session_manager, question_loader,
+                                                                     query_scheduler, grade_cache));
+
+    // Prometheus metrics
+    route("GET", "/metrics", "/metrics", std::make_shared<MetricsHandler>(session_manager, query_scheduler,
+                                                                        grade_cache));
 
     // Login
-    router->route("POST", "/api/login", std::make_shared<LoginHandler>(session_manager));
+    route("POST", "/api/login", "/api/login", std::make_shared<LoginHandler>(session_manager));
 
     // Execute SQL
-    router->route("POST", "/api/execute", std::make_shared<ExecuteHandler>(session_manager, question_loader));
+    route("POST", "/api/execute", "/api/execute", std::make_shared<ExecuteHandler>(session_manager, question_loader,
+                                                                                 query_scheduler, grade_cache,
+                                                                                 engine_grader));
+
+    // Profile a query (per-operator timings and cardinalities)
+    route("POST", "/api/explain", "/api/explain", std::make_shared<ExplainHandler>(session_manager, question_loader,
+                                                                                 query_scheduler));
 
     // List questions
-    router->route("GET", "/api/questions", std::make_shared<ListQuestionsHandler>(question_loader));
+    route("GET", "/api/questions", "/api/questions", std::make_shared<ListQuestionsHandler>(question_loader));
 
     // Get question by slug
-    router->route("GET", "/api/questions/*", std::make_shared<GetQuestionHandler>(question_loader));
+    route("GET", "/api/questions/*", "/api/questions/:slug", std::make_shared<GetQuestionHandler>(question_loader));
 
     // Static files - serve the web interface (catch-all route, must be last)
-    router->route("GET", "/*", std::make_shared<StaticFileHandler>("/home/vagrant/project/cplusplus/web"));
+    route("GET", "/*", "static", std::make_shared<StaticFileHandler>("/home/vagrant/project/cplusplus/web"));
 }
 
 void HTTPServer::run(uint16_t port) {
@@ -669,13 +1287,11 @@ oatpp::Object<ExecuteResponse> Handlers::execute(const std::shared_ptr<ExecuteRe
     }
 
     auto rows = response->rows;
-    for (const auto& row : result.rows) {
+    for (size_t i = 0; i < static_cast<size_t>(result.row_count); ++i) {
         auto rowObj = oatpp::Fields<oatpp::Any>::createShared();
-        for (const auto& col : result.columns) {
-            auto it = row.find(col);
-            if (it != row.end()) {
-                rowObj->push_back({oatpp::String(col.c_str()), oatpp::String(it->second.c_str())});
-            }
+        for (size_t c = 0; c < result.columns.size(); ++c) {
+            rowObj->push_back({oatpp::String(result.columns[c].c_str()),
+                               oatpp::String(result.data[c].to_string(i).c_str())});
         }
         rows->push_back(rowObj);
     }
@@ -703,7 +1319,8 @@ oatpp::List<oatpp::Object<QuestionResponse>> Handlers::listQuestions(
 
     auto questions = question_loader->list_questions(diff_str, cat_str, tag_str, skip_val, limit_val);
 
-    for (const auto& q : questions) {
+    for (const auto& question : questions) {
+        const auto& q = *question;
         auto qr = QuestionResponse::createShared();
         qr->id = oatpp::String(q.id.c_str());
         qr->title = oatpp::String(q.title.c_str());
@@ -738,7 +1355,7 @@ oatpp::Object<QuestionDetailResponse> Handlers::getQuestion(const oatpp::String&
         return response;
     }
 
-    auto q = *question;
+    const auto& q = *question;
     response->id = oatpp::String(q.id.c_str());
     response->title = oatpp::String(q.title.c_str());
     response->slug = oatpp::String(q.slug.c_str());
@@ -762,16 +1379,7 @@ oatpp::Object<QuestionDetailResponse> Handlers::getQuestion(const oatpp::String&
 }
 
 oatpp::String Handlers::health() {
-    size_t active = session_manager ? session_manager->get_active_count() : 0;
-    size_t total = question_loader ? question_loader->get_count() : 0;
-
-    char buffer[256];
-    snprintf(buffer, sizeof(buffer),
-        "{\"status\":\"healthy\",\"active_sessions\":%zu,\"total_questions\":%zu}",
-        active, total
-    );
-
-    return oatpp::String(buffer);
+    return oatpp::String(build_health_json(session_manager, question_loader));
 }
 
 } // namespace sql_practice
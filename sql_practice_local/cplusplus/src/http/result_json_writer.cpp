@@ -0,0 +1,207 @@
+#include "include/result_json_writer.hpp"
+#include <duckdb.hpp>
+#include <charconv>
+#include <cmath>
+#include <type_traits>
+
+namespace sql_practice {
+
+// =============================================================================
+// ResultJsonWriter Implementation
+// =============================================================================
+
+namespace {
+
+// Size of the last response built on this thread, used to pre-size the next
+thread_local size_t last_response_size = 4096;
+
+/**
+ * @brief One chunk column prepared for row-wise writing
+ */
+struct ColumnReader {
+    duckdb::LogicalTypeId type;
+    duckdb::UnifiedVectorFormat format;
+    std::unique_ptr<duckdb::Vector> text;  // VARCHAR cast for non-primitive types
+};
+
+template <typename T>
+void append_number(std::string& out, T value) {
+    char buffer[32];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, end);
+}
+
+template <typename T>
+void append_cell(std::string& out, const duckdb::UnifiedVectorFormat& format, size_t idx) {
+    T value = duckdb::UnifiedVectorFormat::GetDataUnsafe<T>(format)[idx];
+    if constexpr (std::is_same<T, bool>::value) {
+        out += value ? "true" : "false";
+    } else if constexpr (std::is_floating_point<T>::value) {
+        if (std::isfinite(value)) {
+            append_number(out, value);
+        } else {
+            out += std::isnan(value) ? "\"nan\"" : (value < 0 ? "\"-inf\"" : "\"inf\"");
+        }
+    } else {
+        append_number(out, static_cast<int64_t>(value));
+    }
+}
+
+} // namespace
+
+ResultJsonWriter::ResultJsonWriter(size_t max_bytes, size_t max_rows)
+    : max_bytes(max_bytes), max_rows(max_rows), rows_start(0), rows_written(0), rows_open(false) {
+    buffer.reserve(last_response_size);
+}
+
+void ResultJsonWriter::append_escaped(std::string& out, const char* s, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    size_t run = 0;  // Start of the current run of characters needing no escape
+    for (size_t i = 0; i < len; ++i) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out.append(s + run, i - run);
+        run = i + 1;
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xF];
+        }
+    }
+    out.append(s + run, len - run);
+    out += '"';
+}
+
+void ResultJsonWriter::begin(const std::vector<std::string>& columns) {
+    buffer += "{\"columns\":[";
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (i > 0) buffer += ',';
+        append_escaped(buffer, columns[i].data(), columns[i].size());
+    }
+    buffer += "],\"rows\":[";
+    rows_start = buffer.size();
+    rows_open = true;
+}
+
+size_t ResultJsonWriter::append(duckdb::DataChunk& chunk, size_t count, duckdb::ClientContext& context) {
+    size_t column_count = chunk.ColumnCount();
+
+    // Resolve every column's unified format once for the whole chunk
+    std::vector<ColumnReader> readers(column_count);
+    for (size_t col = 0; col < column_count; ++col) {
+        auto& reader = readers[col];
+        auto& vector = chunk.data[col];
+        reader.type = vector.GetType().id();
+        switch (reader.type) {
+            case duckdb::LogicalTypeId::BOOLEAN:
+            case duckdb::LogicalTypeId::TINYINT:
+            case duckdb::LogicalTypeId::SMALLINT:
+            case duckdb::LogicalTypeId::INTEGER:
+            case duckdb::LogicalTypeId::BIGINT:
+            case duckdb::LogicalTypeId::UTINYINT:
+            case duckdb::LogicalTypeId::USMALLINT:
+            case duckdb::LogicalTypeId::UINTEGER:
+            case duckdb::LogicalTypeId::UBIGINT:
+            case duckdb::LogicalTypeId::FLOAT:
+            case duckdb::LogicalTypeId::DOUBLE:
+            case duckdb::LogicalTypeId::VARCHAR:
+                vector.ToUnifiedFormat(count, reader.format);
+                break;
+            default:
+                reader.type = duckdb::LogicalTypeId::VARCHAR;
+                reader.text = std::make_unique<duckdb::Vector>(duckdb::LogicalType::VARCHAR, count);
+                duckdb::VectorOperations::Cast(context, vector, *reader.text, count);
+                reader.text->ToUnifiedFormat(count, reader.format);
+                break;
+        }
+    }
+
+    for (size_t row = 0; row < count; ++row) {
+        if (max_rows > 0 && rows_written >= max_rows) return row;
+
+        size_t row_mark = buffer.size();
+        if (rows_written > 0) buffer += ',';
+        buffer += '[';
+        for (size_t col = 0; col < column_count; ++col) {
+            if (col > 0) buffer += ',';
+            const auto& format = readers[col].format;
+            auto idx = format.sel->get_index(row);
+            if (!format.validity.RowIsValid(idx)) {
+                buffer += "null";
+                continue;
+            }
+            switch (readers[col].type) {
+                case duckdb::LogicalTypeId::BOOLEAN: append_cell<bool>(buffer, format, idx); break;
+                case duckdb::LogicalTypeId::TINYINT: append_cell<int8_t>(buffer, format, idx); break;
+                case duckdb::LogicalTypeId::SMALLINT: append_cell<int16_t>(buffer, format, idx); break;
+                case duckdb::LogicalTypeId::INTEGER: append_cell<int32_t>(buffer, format, idx); break;
+                case duckdb::LogicalTypeId::BIGINT: append_cell<int64_t>(buffer, format, idx); break;
+                case duckdb::LogicalTypeId::UTINYINT: append_cell<uint8_t>(buffer, format, idx); break;
+                case duckdb::LogicalTypeId::USMALLINT: append_cell<uint16_t>(buffer, format, idx); break;
+                case duckdb::LogicalTypeId::UINTEGER: append_cell<uint32_t>(buffer, format, idx); break;
+                case duckdb::LogicalTypeId::UBIGINT:
+                    append_number(buffer, duckdb::UnifiedVectorFormat::GetDataUnsafe<uint64_t>(format)[idx]);
+                    break;
+                case duckdb::LogicalTypeId::FLOAT: append_cell<float>(buffer, format, idx); break;
+                case duckdb::LogicalTypeId::DOUBLE: append_cell<double>(buffer, format, idx); break;
+                default: {
+                    const auto& value = duckdb::UnifiedVectorFormat::GetDataUnsafe<duckdb::string_t>(format)[idx];
+                    append_escaped(buffer, value.GetData(), value.GetSize());
+                    break;
+                }
+            }
+        }
+        buffer += ']';
+
+        if (max_bytes > 0 && buffer.size() - rows_start > max_bytes) {
+            buffer.resize(row_mark);
+            return row;
+        }
+        rows_written++;
+    }
+    return count;
+}
+
+void ResultJsonWriter::close_rows() {
+    if (rows_open) {
+        buffer += ']';
+        rows_open = false;
+    }
+}
+
+void ResultJsonWriter::begin_field(const char* name) {
+    close_rows();
+    if (buffer.empty()) buffer += '{';
+    if (buffer.back() != '{') buffer += ',';
+    buffer += '"';
+    buffer += name;
+    buffer += "\":";
+}
+
+void ResultJsonWriter::write_field(const char* name, bool value) {
+    begin_field(name);
+    buffer += value ? "true" : "false";
+}
+
+void ResultJsonWriter::write_field(const char* name, int64_t value) {
+    begin_field(name);
+    append_number(buffer, value);
+}
+
+std::string ResultJsonWriter::release() {
+    if (buffer.empty()) buffer += '{';
+    close_rows();
+    buffer += '}';
+    last_response_size = buffer.size();
+    return std::move(buffer);
+}
+
+} // namespace sql_practice
@@ -0,0 +1,152 @@
+#ifndef CANONICAL_CELL_HPP
+#define CANONICAL_CELL_HPP
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string_view>
+
+namespace sql_practice {
+
+/**
+ * @brief A result cell reduced to the value grading compares
+ *
+ * The one definition of cell equality: ResultColumn::cell_equals,
+ * ResultColumn::hash and the streaming fingerprint all go through it, so
+ * the grader's hash buckets, its row comparison and the fingerprint agree.
+ *
+ * - NULL equals only NULL
+ * - Integers, and doubles with an integral value, are INTEGER
+ *   (90000 = 90000.0, -0.0 = 0)
+ * - Other doubles are DOUBLE, compared bit for bit; every NaN is one value
+ * - Booleans are the text "true" / "false"
+ * - Text spelling a number (DECIMAL, HUGEINT, UBIGINT are kept as text)
+ *   takes that number's form; any other text compares by its bytes
+ *
+ * TEXT cells point into the caller's string, which must outlive the cell.
+ */
+struct CanonicalCell {
+    enum class Kind : uint8_t { NULL_VALUE, INTEGER, DOUBLE, TEXT };
+
+    Kind kind = Kind::NULL_VALUE;
+    int64_t integer = 0;
+    uint64_t double_bits = 0;
+    std::string_view text;
+
+    static CanonicalCell null() { return CanonicalCell(); }
+
+    static CanonicalCell from_int(int64_t value) {
+        CanonicalCell cell;
+        cell.kind = Kind::INTEGER;
+        cell.integer = value;
+        return cell;
+    }
+
+    static CanonicalCell from_double(double value) {
+        // [-2^63, 2^63) holds every integral double that fits an int64
+        if (std::isfinite(value) && value == std::trunc(value) &&
+            value >= -9223372036854775808.0 && value < 9223372036854775808.0) {
+            return from_int(static_cast<int64_t>(value));
+        }
+        if (std::isnan(value)) value = std::numeric_limits<double>::quiet_NaN();
+
+        CanonicalCell cell;
+        cell.kind = Kind::DOUBLE;
+        std::memcpy(&cell.double_bits, &value, sizeof(value));
+        return cell;
+    }
+
+    static CanonicalCell from_unsigned(uint64_t value) {
+        // Above INT64_MAX the digits would parse as a double, so go there directly
+        if (value <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            return from_int(static_cast<int64_t>(value));
+        }
+        return from_double(static_cast<double>(value));
+    }
+
+    static CanonicalCell from_bool(bool value) {
+        return from_text(value ? "true" : "false", value ? 4 : 5);
+    }
+
+    static CanonicalCell from_text(const char* data, size_t size) {
+        const char* end = data + size;
+        if (size > 0) {
+            int64_t as_int;
+            auto int_parse = std::from_chars(data, end, as_int);
+            if (int_parse.ec == std::errc() && int_parse.ptr == end) return from_int(as_int);
+
+            double as_double;
+            auto double_parse = std::from_chars(data, end, as_double);
+            if (double_parse.ec == std::errc() && double_parse.ptr == end) return from_double(as_double);
+        }
+
+        CanonicalCell cell;
+        cell.kind = Kind::TEXT;
+        cell.text = std::string_view(data, size);
+        return cell;
+    }
+
+    bool operator==(const CanonicalCell& other) const {
+        if (kind != other.kind) return false;
+        switch (kind) {
+            case Kind::NULL_VALUE: return true;
+            case Kind::INTEGER: return integer == other.integer;
+            case Kind::DOUBLE: return double_bits == other.double_bits;
+            case Kind::TEXT: return text == other.text;
+        }
+        return false;
+    }
+    bool operator!=(const CanonicalCell& other) const { return !(*this == other); }
+
+    /**
+     * @brief Hash that is equal whenever operator== holds
+     */
+    uint64_t hash() const {
+        switch (kind) {
+            case Kind::NULL_VALUE: return 0x9ae16a3b2f90404fULL;
+            case Kind::INTEGER: return mix64(static_cast<uint64_t>(integer) ^ 0x2545f4914f6cdd1dULL);
+            case Kind::DOUBLE: return mix64(double_bits ^ 0x94d049bb133111ebULL);
+            case Kind::TEXT: return mix64(std::hash<std::string_view>()(text) ^ 0xbf58476d1ce4e5b9ULL);
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Second hash, independent of hash(), for the 128-bit fingerprint
+     *
+     * Text goes through FNV-1a rather than std::hash, so two cells whose
+     * hash() collides almost never collide here as well.
+     */
+    uint64_t alt_hash() const {
+        switch (kind) {
+            case Kind::NULL_VALUE: return 0x3c6ef372fe94f82bULL;
+            case Kind::INTEGER: return mix64(static_cast<uint64_t>(integer) * 0xa0761d6478bd642fULL + 1);
+            case Kind::DOUBLE: return mix64(double_bits * 0xe7037ed1a0b428dbULL + 2);
+            case Kind::TEXT: {
+                uint64_t h = 0x84222325cbf29ce4ULL;
+                for (unsigned char c : text) {
+                    h ^= c;
+                    h *= 0x100000001b3ULL;
+                }
+                return mix64(h + 3);
+            }
+        }
+        return 0;
+    }
+
+    static uint64_t mix64(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+};
+
+} // namespace sql_practice
+
+#endif // CANONICAL_CELL_HPP
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace sql_practice {
@@ -15,9 +16,63 @@ extern std::string log_level;
 // =============================================================================
 // Shared DuckDB Instance Architecture
 // =============================================================================
-// Configurable: Connections per DuckDB instance
+// Sessions share N DuckDB instances (N = max_concurrent_sessions / connections
+// per instance) instead of creating one instance each.
+// Default connections per DuckDB instance
 // Adjust based on benchmarking (test: 100, 250, 500, 1000)
 constexpr int CONNECTIONS_PER_INSTANCE = 500;
 
+// Runtime value, overridable with CONNECTIONS_PER_INSTANCE so the load tester
+// can compare settings without a rebuild
+extern int connections_per_instance;
+
+// Path of the shared read-only fixture database (empty = temp directory)
+extern std::string fixture_db_path;
+
+// Question schemas each session keeps loaded (LRU) for fast switching
+extern int question_schema_cache_size;
+
+// Result caps per query; rows past either limit are not fetched (0 = unlimited)
+extern int max_result_rows;
+extern int64_t max_result_bytes;
+
+// Per-query wall-clock limit in milliseconds (0 = none). The per-difficulty
+// values override the global one when set (> 0).
+extern int query_timeout_ms;
+extern int query_timeout_easy_ms;
+extern int query_timeout_medium_ms;
+extern int query_timeout_hard_ms;
+
+// Timeout that applies to a question of the given difficulty
+int query_timeout_for(const std::string& difficulty);
+
+// DuckDB resource governor. These are budgets for the whole server: each of
+// the session pool's N instances (plus the in-engine grading instance, when
+// enabled) gets memory, threads (at least one) and temp space divided by
+// their count, and spills to its own subdirectory of the temp
+// directory. Empty memory / temp size keeps DuckDB's default (80% of RAM per
+// instance, no temp size cap); 0 threads budgets one per hardware thread.
+extern std::string duckdb_memory_limit;
+extern int duckdb_threads;
+extern std::string duckdb_temp_directory;
+extern std::string duckdb_max_temp_directory_size;
+
+// Query execution pool: fixed worker threads (0 = one per hardware thread)
+// and how many queries may wait for one before /api/execute answers 503
+extern int query_workers;
+extern int query_queue_capacity;
+
+// Graded responses kept for identical (question, normalized SQL) submissions
+// (0 = only coalesce concurrent duplicates)
+extern int grade_cache_size;
+
+// Unordered questions whose expected output has at least this many rows are
+// graded inside DuckDB with EXCEPT ALL, on a grading-only instance that gets
+// one more share of the resource budget above (0 = always grade in C++)
+extern int engine_grade_min_rows;
+
+// Load from environment or config file
+void load_config(const std::string& config_file = "");
+
 } // namespace Config
 } // namespace sql_practice
@@ -0,0 +1,88 @@
+#ifndef ENGINE_GRADER_HPP
+#define ENGINE_GRADER_HPP
+
+#include "sql_executor.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace sql_practice {
+
+class DuckDBInstancePool;
+class FixtureCatalog;
+class QuestionLoader;
+struct Question;
+
+/**
+ * @brief Grades unordered answers inside DuckDB with EXCEPT ALL
+ *
+ * Owns a DuckDB instance that is never leased to a session. The instance
+ * attaches the fixture catalog READ_ONLY, as session instances do, and
+ * holds each question's expected output as a typed table in an in-memory
+ * catalog (EXPECTED_CATALOG) that exists only there. Student SQL never
+ * runs on a connection that can see it, and validate() rejects "__" names
+ * anyway.
+ *
+ * grade() runs the submission on the fixture tables and returns only the
+ * size of (submission EXCEPT ALL expected) UNION ALL (expected EXCEPT ALL
+ * submission), so the submission's rows never leave DuckDB. Cells on both
+ * sides first go through a macro that mirrors CanonicalCell: 90000,
+ * 90000.0 and '90000' are one value, every NaN is one value, and -0.0 = 0.
+ */
+class EngineGrader {
+private:
+    std::shared_ptr<DuckDBInstancePool> pool;
+    std::unordered_set<std::string> questions;  // Expected table and fixture schema both present
+
+    std::mutex idle_mutex;
+    std::vector<std::unique_ptr<DuckDBConnection>> idle;  // Grading connections not in use
+
+    std::unique_ptr<DuckDBConnection> open_connection();
+
+public:
+    // In-memory catalog on the grading instance holding expected outputs
+    static constexpr const char* EXPECTED_CATALOG = "__expected";
+
+    // Table holding a question's expected output, in schema <question_id>
+    static constexpr const char* EXPECTED_TABLE = "expected_output";
+
+    /**
+     * @brief Build the grading instance and load every expected output
+     *
+     * Run after derive_expected_outputs so the tables hold the derived rows.
+     * budget_shares is passed to the instance pool; the session pool leaves
+     * one share of the DuckDB budget for this instance.
+     *
+     * @throws std::runtime_error if the grading instance cannot be set up
+     */
+    EngineGrader(const FixtureCatalog& catalog, const QuestionLoader& loader, size_t budget_shares);
+    ~EngineGrader();
+
+    EngineGrader(const EngineGrader&) = delete;
+    EngineGrader& operator=(const EngineGrader&) = delete;
+
+    /**
+     * @brief True if grade() can be used for this question
+     */
+    bool covers(const std::string& question_id) const { return questions.count(question_id) > 0; }
+
+    size_t get_question_count() const { return questions.size(); }
+
+    /**
+     * @brief Grade a single SELECT (ParsedQuery::select_sql) against question
+     *
+     * Unqualified table names resolve in the question's fixture schema, as
+     * they do for a session that has not modified its tables. Columns are
+     * compared by position; the caller checks the names. is_correct is set
+     * when the symmetric difference is empty. A query still running after
+     * timeout_ms fails with timed_out set; any other failure (a name that
+     * only resolves in the session catalog, ...) leaves success false.
+     */
+    QueryResult grade(const std::string& select_sql, const Question& question, int timeout_ms);
+};
+
+} // namespace sql_practice
+
+#endif // ENGINE_GRADER_HPP
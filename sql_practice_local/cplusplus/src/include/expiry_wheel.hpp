@@ -0,0 +1,72 @@
+#ifndef EXPIRY_WHEEL_HPP
+#define EXPIRY_WHEEL_HPP
+
+#include "session_token.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sql_practice {
+
+/**
+ * @brief Hierarchical timer wheel of session deadlines, one tick per second
+ *
+ * Four levels of 64 slots cover 64 s, ~68 min, ~73 h and ~194 days. A
+ * deadline goes to the lowest level whose span still contains it. When
+ * the clock crosses a level boundary, that level's current slot is
+ * redistributed to the levels below it. Scheduling is O(1) and each entry
+ * is moved at most once per level. Deadlines past the top level are
+ * clamped; the owner re-arms entries that fire early. Not thread-safe.
+ */
+class ExpiryWheel {
+public:
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr size_t SLOTS = size_t(1) << LEVEL_BITS;
+    static constexpr int LEVELS = 4;
+
+    explicit ExpiryWheel(uint64_t start_tick = 0) : now(start_tick), count(0) {}
+
+    /**
+     * @brief Fire token at deadline_tick (next tick if already past)
+     */
+    void schedule(const SessionToken& token, uint64_t deadline_tick);
+
+    /**
+     * @brief Advance to now_tick, calling on_due(token) for every deadline reached
+     */
+    template <typename Fn>
+    void advance(uint64_t now_tick, Fn on_due) {
+        while (now < now_tick) {
+            tick();
+            auto& due = slots[0][now & (SLOTS - 1)];
+            count -= due.size();
+            for (const auto& entry : due) on_due(entry.token);
+            due.clear();
+        }
+    }
+
+    uint64_t current_tick() const { return now; }
+    size_t size() const { return count; }
+
+private:
+    struct Entry {
+        SessionToken token;
+        uint64_t deadline;
+    };
+
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> slots;
+    uint64_t now;
+    size_t count;
+
+    void place(const Entry& entry);
+
+    /**
+     * @brief Move to now + 1, cascading any level whose boundary is crossed
+     */
+    void tick();
+};
+
+} // namespace sql_practice
+
+#endif // EXPIRY_WHEEL_HPP
@@ -0,0 +1,71 @@
+#ifndef FIXTURE_CATALOG_HPP
+#define FIXTURE_CATALOG_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace sql_practice {
+
+class QuestionLoader;
+
+/**
+ * @brief Read-only database holding every question's fixture tables
+ *
+ * Built once at startup into a DuckDB file with one schema per question
+ * (fixtures.<question_id>.<table>). Every pooled DuckDB instance attaches
+ * the file READ_ONLY, and sessions query it through views instead of
+ * replaying CREATE TABLE + INSERT into their own catalog.
+ *
+ * Every session can read this catalog, so it holds fixture tables only:
+ * expected outputs stay in memory on each Question and in the EngineGrader's
+ * own catalog.
+ */
+class FixtureCatalog {
+private:
+    std::string db_path;
+    uint64_t version;
+
+public:
+    // Name the file is attached under on every pooled instance
+    static constexpr const char* CATALOG_NAME = "fixtures";
+
+    /**
+     * @brief Empty path selects a per-process file in the temp directory
+     */
+    explicit FixtureCatalog(const std::string& path = "");
+
+    /**
+     * @brief Removes the fixture database file
+     */
+    ~FixtureCatalog();
+
+    FixtureCatalog(const FixtureCatalog&) = delete;
+    FixtureCatalog& operator=(const FixtureCatalog&) = delete;
+
+    /**
+     * @brief Create the fixture file from all loaded questions
+     *
+     * Questions whose schema fails to build are skipped; sessions fall back
+     * to a private copy for those.
+     *
+     * @return Number of questions built
+     * @throws std::runtime_error if the database file cannot be created
+     */
+    size_t build(const QuestionLoader& loader);
+
+    const std::string& get_path() const { return db_path; }
+
+    /**
+     * @brief Identifies the current build; changes every time build() runs
+     */
+    uint64_t get_version() const { return version; }
+
+    /**
+     * @brief Schema holding a question's tables inside the fixture catalog
+     */
+    static std::string schema_for(const std::string& question_id);
+};
+
+} // namespace sql_practice
+
+#endif // FIXTURE_CATALOG_HPP
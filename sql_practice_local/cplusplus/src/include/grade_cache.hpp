@@ -0,0 +1,113 @@
+#ifndef GRADE_CACHE_HPP
+#define GRADE_CACHE_HPP
+
+#include <oatpp/core/Types.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace sql_practice {
+
+/**
+ * @brief Finished /api/execute response, shareable between requests
+ *
+ * The body is an oatpp::String, which holds its buffer by shared_ptr:
+ * every response built from a cached entry shares that one buffer.
+ */
+struct GradeResponse {
+    int status_code;
+    oatpp::String body;
+    bool cacheable = false;  // A graded read-only query against unmodified fixtures
+};
+
+/**
+ * @brief Identity of a graded submission
+ *
+ * normalized_sql is compared on lookup so a hash collision can never serve
+ * another query's grade.
+ */
+struct GradeKey {
+    std::string question_id;
+    uint64_t fixture_version;
+    uint64_t sql_hash;
+    std::string normalized_sql;
+
+    bool operator==(const GradeKey& other) const {
+        return sql_hash == other.sql_hash && fixture_version == other.fixture_version &&
+               question_id == other.question_id && normalized_sql == other.normalized_sql;
+    }
+};
+
+struct GradeKeyHash {
+    size_t operator()(const GradeKey& key) const {
+        return static_cast<size_t>(key.sql_hash ^ (key.fixture_version * 0x9E3779B97F4A7C15ULL) ^
+                                   std::hash<std::string>()(key.question_id));
+    }
+};
+
+/**
+ * @brief Snapshot of grade cache counters
+ */
+struct GradeCacheStats {
+    size_t entries;
+    uint64_t hits;       // Served from a stored response
+    uint64_t misses;     // Executed by this request
+    uint64_t coalesced;  // Waited on an identical in-flight execution
+};
+
+/**
+ * @brief LRU cache of graded responses with single-flight execution
+ *
+ * Concurrent requests for the same key share one execution: the first
+ * runs compute(), the others wait for its response. Only responses that
+ * compute() marked cacheable are stored; errors and timeouts are shared
+ * with waiters but not kept.
+ */
+class GradeCache {
+private:
+    using Entry = std::pair<GradeKey, std::shared_ptr<const GradeResponse>>;
+
+    size_t capacity;
+    std::list<Entry> order;  // Most recently used first
+    std::unordered_map<GradeKey, std::list<Entry>::iterator, GradeKeyHash> index;
+    std::unordered_map<GradeKey, std::shared_future<std::shared_ptr<const GradeResponse>>, GradeKeyHash> in_flight;
+    mutable std::mutex cache_mutex;
+
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> coalesced;
+
+    void store(const GradeKey& key, std::shared_ptr<const GradeResponse> response);
+
+public:
+    /**
+     * @param capacity Stored responses (0 disables storing; in-flight
+     *                 requests are still coalesced)
+     */
+    explicit GradeCache(size_t capacity);
+
+    /**
+     * @brief Cached response for key, or the result of compute()
+     *
+     * @param cached Set to true when the response did not come from this
+     *               caller's own compute()
+     * @throws Whatever compute() throws, to the caller and all waiters
+     */
+    std::shared_ptr<const GradeResponse> get_or_compute(
+        const GradeKey& key,
+        const std::function<GradeResponse()>& compute,
+        bool& cached
+    );
+
+    GradeCacheStats get_stats() const;
+};
+
+} // namespace sql_practice
+
+#endif // GRADE_CACHE_HPP
@@ -3,6 +3,8 @@
 
 #include "session_manager.hpp"
 #include "question_loader.hpp"
+#include "query_scheduler.hpp"
+#include "grade_cache.hpp"
 #include <oatpp/web/server/HttpConnectionHandler.hpp>
 #include <oatpp/web/server/HttpRouter.hpp>
 #include <oatpp/network/Server.hpp>
@@ -12,6 +14,8 @@
 
 namespace sql_practice {
 
+class EngineGrader;
+
 /**
  * @brief HTTP request/response DTOs
  */
@@ -73,13 +77,20 @@ class HTTPServer {
 private:
     std::shared_ptr<SessionManager> session_manager;
     std::shared_ptr<QuestionLoader> question_loader;
+    std::shared_ptr<QueryScheduler> query_scheduler;
+    std::shared_ptr<GradeCache> grade_cache;
+    std::shared_ptr<EngineGrader> engine_grader;
     std::shared_ptr<oatpp::network::Server> server;
     std::shared_ptr<oatpp::web::server::HttpRouter> router;
 
 public:
+    /**
+     * @brief eg grades large unordered answers inside DuckDB (null = always in C++)
+     */
     HTTPServer(
         std::shared_ptr<SessionManager> sm,
-        std::shared_ptr<QuestionLoader> ql
+        std::shared_ptr<QuestionLoader> ql,
+        std::shared_ptr<EngineGrader> eg = nullptr
     );
 
     /**
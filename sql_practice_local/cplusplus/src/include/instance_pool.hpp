@@ -0,0 +1,124 @@
+#ifndef INSTANCE_POOL_HPP
+#define INSTANCE_POOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace duckdb {
+class DuckDB;
+}
+
+namespace sql_practice {
+
+/**
+ * @brief Load counters for a single shared DuckDB instance
+ */
+struct InstanceLoadStats {
+    size_t instance_id;
+    bool initialized;              // Instance is created lazily on first lease
+    size_t active_connections;     // Sessions currently leased to this instance
+    size_t peak_connections;       // High-water mark of active_connections
+    uint64_t total_connections;    // Leases handed out since startup
+    uint64_t memory_used_bytes;    // Buffer manager allocation (0 when not initialized)
+    uint64_t memory_limit_bytes;   // Buffer manager limit (0 when not initialized)
+    size_t threads;                // DuckDB worker threads (0 when not initialized)
+};
+
+/**
+ * @brief Lease on a shared DuckDB instance held by one session
+ */
+struct InstanceLease {
+    size_t instance_id;
+    duckdb::DuckDB* database;
+    bool has_fixtures;  // Shared fixture catalog is attached on this instance
+};
+
+/**
+ * @brief Pool of shared DuckDB instances
+ *
+ * Instead of one DuckDB per session, N instances are shared by all sessions
+ * (N = max_sessions / connections_per_instance). Each session leases the
+ * least-loaded instance and opens its own Connection on it; the lease is
+ * returned when the session's DuckDBConnection is destroyed. Instances are
+ * created without DuckDB's default "memory" catalog, so sessions on one
+ * instance share no writable catalog.
+ */
+class DuckDBInstancePool {
+private:
+    struct Instance {
+        std::unique_ptr<duckdb::DuckDB> db;
+        std::atomic<size_t> active{0};
+        std::atomic<size_t> peak{0};
+        std::atomic<uint64_t> total{0};
+        bool has_fixtures = false;
+    };
+
+    std::vector<std::unique_ptr<Instance>> instances;
+    size_t connections_per_instance;
+    size_t budget_shares;  // Parts the server-wide DuckDB budget is split into
+    std::string fixture_path;
+    std::atomic<uint64_t> fixture_version{0};
+    mutable std::mutex assign_mutex;  // Guards instance selection and lazy creation
+
+    bool attach_fixtures(Instance& instance);
+
+public:
+    /**
+     * @brief Pool whose instances each get 1 / budget_shares of the DuckDB budget
+     *
+     * budget_shares 0 splits the budget across this pool's instances only;
+     * a larger value leaves shares for instances owned elsewhere (e.g. the
+     * in-engine grader).
+     */
+    DuckDBInstancePool(size_t instance_count, size_t connections_per_instance, size_t budget_shares = 0);
+    ~DuckDBInstancePool();
+
+    DuckDBInstancePool(const DuckDBInstancePool&) = delete;
+    DuckDBInstancePool& operator=(const DuckDBInstancePool&) = delete;
+
+    /**
+     * @brief Number of instances needed for max_sessions (at least 1)
+     */
+    static size_t instances_for(size_t max_sessions, size_t connections_per_instance);
+
+    /**
+     * @brief Lease the least-loaded instance, creating it on first use
+     *
+     * Instances above connections_per_instance still accept leases; the
+     * limit is a sizing target, not a hard cap. Throws std::runtime_error
+     * if a new instance cannot be set up.
+     */
+    InstanceLease acquire();
+
+    /**
+     * @brief Return a lease obtained from acquire()
+     */
+    void release(size_t instance_id);
+
+    /**
+     * @brief Attach the read-only fixture database on every instance
+     *
+     * Applied to instances that already exist and to those created later.
+     * version identifies the fixture build (FixtureCatalog::get_version()).
+     */
+    void set_fixture_catalog(const std::string& path, uint64_t version);
+
+    uint64_t get_fixture_version() const { return fixture_version.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Snapshot of per-instance load counters
+     */
+    std::vector<InstanceLoadStats> get_load_stats() const;
+
+    size_t get_instance_count() const { return instances.size(); }
+    size_t get_connections_per_instance() const { return connections_per_instance; }
+    size_t get_budget_shares() const { return budget_shares; }
+};
+
+} // namespace sql_practice
+
+#endif // INSTANCE_POOL_HPP
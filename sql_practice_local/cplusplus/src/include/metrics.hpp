@@ -0,0 +1,207 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+namespace sql_practice {
+
+/**
+ * @brief Stripes per metric; each thread always writes the same stripe
+ *
+ * Storage is a fixed set of stripes, not per-thread: threads are assigned
+ * stripes round-robin on first use, and a stripe is never given back.
+ * Only the first METRIC_SHARDS recording threads get a stripe of their
+ * own. The server records from many more: one thread per HTTP connection
+ * (HttpConnectionHandler), the query workers, the solution workers at
+ * startup, the expiry thread and the reaper. So stripes are shared, and
+ * with T threads ever recorded roughly T / METRIC_SHARDS land on each.
+ * Updates stay correct (every one is atomic); threads on the same stripe
+ * contend for its cache line only when they record at the same moment,
+ * which at most as many threads as there are cores can do. Above 16
+ * cores, expect that contention on busy counters.
+ */
+constexpr size_t METRIC_SHARDS = 16;
+
+/**
+ * @brief Stripe of the calling thread, in [0, METRIC_SHARDS)
+ */
+size_t metric_shard();
+
+/**
+ * @brief Monotonic counter striped across cache-line-padded slots
+ *
+ * add() is a relaxed increment of the caller's own slot; value() sums
+ * the slots and is only used at scrape time.
+ */
+class ShardedCounter {
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Slot, METRIC_SHARDS> slots;
+
+public:
+    void add(uint64_t n = 1) { slots[metric_shard()].value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const;
+};
+
+/**
+ * @brief Latency histogram with HDR-style log-linear buckets
+ *
+ * Values are microseconds. Below 16 us every value has its own bucket;
+ * above, each power of two is split into 8 linear sub-buckets, so the
+ * bucket width never exceeds 12.5% of its value. Values of 2^41 us and
+ * above land in the last bucket. Recording is one relaxed increment of a
+ * bucket and of the sum in the caller's stripe.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr int MAX_MAGNITUDE = 40;
+    // SUB_BUCKETS exact buckets below 2^SUB_BUCKET_BITS, then SUB_BUCKETS per
+    // magnitude SUB_BUCKET_BITS..MAX_MAGNITUDE
+    static constexpr size_t BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    // Every EXPORT_STRIDE-th bucket bound is exported, two per power of two
+    static constexpr size_t EXPORT_STRIDE = SUB_BUCKETS / 2;
+
+    /**
+     * @brief Bucket holding a value (negative values count as 0)
+     */
+    static size_t bucket_for(int64_t us);
+
+    /**
+     * @brief Largest value held by a bucket (inclusive upper bound)
+     */
+    static uint64_t bucket_upper_us(size_t bucket);
+
+    /**
+     * @brief Merged view of all stripes
+     */
+    struct Snapshot {
+        std::array<uint64_t, BUCKET_COUNT> counts{};
+        uint64_t count = 0;
+        uint64_t sum_us = 0;
+    };
+
+    void record(int64_t us);
+    Snapshot snapshot() const;
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts{};
+        std::atomic<uint64_t> sum_us{0};
+    };
+    std::array<Shard, METRIC_SHARDS> shards;
+};
+
+/**
+ * @brief Requests and latency of one HTTP route
+ */
+struct RouteMetrics {
+    std::string route;
+    ShardedCounter responses_2xx;
+    ShardedCounter responses_4xx;
+    ShardedCounter responses_5xx;
+    LatencyHistogram latency;
+
+    explicit RouteMetrics(std::string name) : route(std::move(name)) {}
+
+    void record(int status_code, int64_t us);
+};
+
+/**
+ * @brief Process-wide metrics recorded on the hot path
+ *
+ * Gauges (sessions, pool memory, queue depth, threads) are read from
+ * their owners at scrape time instead of being mirrored here.
+ */
+class Metrics {
+private:
+    std::deque<RouteMetrics> routes;  // Stable addresses for handlers
+    std::mutex routes_mutex;          // Guards registration only
+
+public:
+    static Metrics& shared();
+
+    /**
+     * @brief Metrics for a route, created on first call (at router setup)
+     */
+    RouteMetrics* route(const std::string& name);
+
+    /**
+     * @brief Visit every registered route
+     */
+    template <typename Fn>
+    void for_each_route(Fn fn) {
+        std::lock_guard<std::mutex> lock(routes_mutex);
+        for (const auto& route : routes) fn(route);
+    }
+
+    // Query execution on the query workers (/api/execute and /api/explain)
+    LatencyHistogram query_execution;
+    ShardedCounter queries_succeeded;
+    ShardedCounter queries_failed;
+    ShardedCounter queries_timed_out;
+
+    // Session lifecycle
+    ShardedCounter sessions_created;
+    ShardedCounter sessions_expired;
+    ShardedCounter sessions_terminated;
+    LatencyHistogram session_cleanup;
+    LatencyHistogram session_teardown;  // One SessionReaper batch
+};
+
+/**
+ * @brief Builder for the Prometheus text exposition format (version 0.0.4)
+ *
+ * Call family() once before the samples of each metric name.
+ */
+class PrometheusWriter {
+private:
+    std::string out;
+
+public:
+    PrometheusWriter() { out.reserve(16384); }
+
+    void family(const char* name, const char* type, const char* help);
+
+    /**
+     * @brief One sample; labels is the inner part of {...}, e.g. route="/health"
+     */
+    void sample(const char* name, const std::string& labels, double value);
+    void sample(const char* name, const std::string& labels, uint64_t value);
+
+    /**
+     * @brief _bucket/_sum/_count series of a histogram in seconds
+     *
+     * Every scrape writes the same le bounds: every EXPORT_STRIDE-th bucket
+     * bound (two per power of two, exact cumulative counts) plus le="+Inf".
+     * Skipping empty buckets would make series come and go, which breaks
+     * rate() and histogram_quantile().
+     */
+    void histogram(const char* name, const std::string& labels, const LatencyHistogram& histogram);
+
+    /**
+     * @brief Escape a label value (backslash, quote, newline)
+     */
+    static std::string label_value(const std::string& value);
+
+    std::string release() { return std::move(out); }
+};
+
+/**
+ * @brief Threads of this process (from /proc/self/status), 0 if unavailable
+ */
+size_t process_thread_count();
+
+} // namespace sql_practice
+
+#endif // METRICS_HPP
@@ -0,0 +1,87 @@
+#ifndef QUERY_SCHEDULER_HPP
+#define QUERY_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sql_practice {
+
+/**
+ * @brief Fixed pool of query workers fed by a bounded queue
+ *
+ * HTTP connection threads hand query work to the scheduler and wait for
+ * the result, so at most worker_count queries run at once regardless of how
+ * many connections are open. When queue_capacity tasks are already waiting,
+ * submit() refuses new work and the caller answers 503 instead of piling
+ * more threads onto DuckDB.
+ */
+class QueryScheduler {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    size_t queue_capacity;
+    mutable std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    bool stopping;
+
+    std::atomic<size_t> busy_workers;
+    std::atomic<uint64_t> rejected_count;
+
+    void worker_loop();
+    bool try_enqueue(std::function<void()> task);
+
+public:
+    /**
+     * @param worker_count Worker threads (0 = one per hardware thread)
+     * @param queue_capacity Tasks allowed to wait for a worker
+     */
+    QueryScheduler(size_t worker_count, size_t queue_capacity);
+
+    /**
+     * @brief Stops the workers; tasks still queued are dropped
+     */
+    ~QueryScheduler();
+
+    QueryScheduler(const QueryScheduler&) = delete;
+    QueryScheduler& operator=(const QueryScheduler&) = delete;
+
+    /**
+     * @brief Queue fn for a worker
+     *
+     * @return Future for fn's result, or nullopt if the queue is full
+     */
+    template <typename Fn>
+    std::optional<std::future<std::invoke_result_t<Fn>>> submit(Fn&& fn) {
+        using Result = std::invoke_result_t<Fn>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+        auto future = task->get_future();
+        if (!try_enqueue([task]() { (*task)(); })) {
+            return std::nullopt;
+        }
+        return future;
+    }
+
+    /**
+     * @brief Ready to take traffic: queue is below three quarters full
+     */
+    bool is_ready() const;
+
+    size_t get_queue_depth() const;
+    size_t get_queue_capacity() const { return queue_capacity; }
+    size_t get_worker_count() const { return workers.size(); }
+    size_t get_busy_workers() const { return busy_workers.load(std::memory_order_relaxed); }
+    uint64_t get_rejected_count() const { return rejected_count.load(std::memory_order_relaxed); }
+};
+
+} // namespace sql_practice
+
+#endif // QUERY_SCHEDULER_HPP
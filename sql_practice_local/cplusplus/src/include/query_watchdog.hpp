@@ -0,0 +1,82 @@
+#ifndef QUERY_WATCHDOG_HPP
+#define QUERY_WATCHDOG_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace duckdb {
+class Connection;
+}
+
+namespace sql_practice {
+
+/**
+ * @brief Enforces per-query deadlines with one background thread
+ *
+ * A query is armed with its connection and timeout before it starts and
+ * disarmed when it finishes. If the deadline passes first, the watchdog
+ * calls duckdb::Connection::Interrupt(), which makes the running query fail
+ * at its next interrupt check; disarm() then reports that the query timed
+ * out. Interrupt is only ever called between arm() and disarm(), so the
+ * connection is guaranteed to be alive.
+ */
+class QueryWatchdog {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        duckdb::Connection* conn;
+        std::multimap<Clock::time_point, uint64_t>::iterator deadline;
+        bool fired;
+    };
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::multimap<Clock::time_point, uint64_t> deadlines;  // Earliest first
+    std::unordered_map<uint64_t, Entry> armed;
+    uint64_t next_id;
+    bool stopping;
+    std::atomic<uint64_t> timeout_count;
+    std::thread worker;
+
+    void run();
+
+public:
+    QueryWatchdog();
+    ~QueryWatchdog();
+
+    QueryWatchdog(const QueryWatchdog&) = delete;
+    QueryWatchdog& operator=(const QueryWatchdog&) = delete;
+
+    /**
+     * @brief Process-wide watchdog used by DuckDBConnection::execute
+     */
+    static QueryWatchdog& shared();
+
+    /**
+     * @brief Start watching a query; returns a handle for disarm()
+     */
+    uint64_t arm(duckdb::Connection* conn, int timeout_ms);
+
+    /**
+     * @brief Stop watching a query
+     *
+     * @return true if the deadline passed and the query was interrupted
+     */
+    bool disarm(uint64_t handle);
+
+    /**
+     * @brief Queries interrupted since startup
+     */
+    uint64_t get_timeout_count() const { return timeout_count.load(std::memory_order_relaxed); }
+};
+
+} // namespace sql_practice
+
+#endif // QUERY_WATCHDOG_HPP
@@ -2,10 +2,12 @@
 #define QUESTION_LOADER_HPP
 
 #include "sql_executor.hpp"
+#include "result_grader.hpp"
+#include "result_fingerprint.hpp"
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
-#include <optional>
 
 namespace sql_practice {
 
@@ -22,21 +24,27 @@ struct Question {
     std::string company;     // FAANG, etc.
     QuestionSchema schema;
     QueryResult expected_output;
+    ResultFingerprint expected_fingerprint;  // Computed once from expected_output
     std::string starter_code;
     std::vector<std::string> hints;
     std::string solution;    // Optional
     std::vector<std::string> tags;
+    std::vector<std::string> allowed_statements;  // Statement types students may run; empty = SELECT only
+    GradeMode grade_mode = GradeMode::UNORDERED;
 };
 
 /**
  * @brief Loads questions from embedded data
  *
- * Questions are compiled into the binary for zero-dependency deployment
+ * Questions are compiled into the binary for zero-dependency deployment.
+ * Each question is stored once as a shared immutable instance, indexed by
+ * both id and slug; lookups hand out that instance instead of copying its
+ * expected output and sample data.
  */
 class QuestionLoader {
 private:
-    std::unordered_map<std::string, Question> questions_by_slug;
-    std::unordered_map<std::string, Question> questions_by_id;
+    std::unordered_map<std::string, std::shared_ptr<const Question>> questions_by_slug;
+    std::unordered_map<std::string, std::shared_ptr<const Question>> questions_by_id;
 
 public:
     QuestionLoader() = default;
@@ -48,19 +56,19 @@ public:
     void load_embedded_questions();
 
     /**
-     * @brief Get question by slug
+     * @brief Get question by slug, or nullptr
      */
-    std::optional<Question> get_question_by_slug(const std::string& slug) const;
+    std::shared_ptr<const Question> get_question_by_slug(const std::string& slug) const;
 
     /**
-     * @brief Get question by ID
+     * @brief Get question by ID, or nullptr
      */
-    std::optional<Question> get_question_by_id(const std::string& id) const;
+    std::shared_ptr<const Question> get_question_by_id(const std::string& id) const;
 
     /**
      * @brief List all questions with optional filtering
      */
-    std::vector<Question> list_questions(
+    std::vector<std::shared_ptr<const Question>> list_questions(
         const std::string& question_difficulty = "",
         const std::string& category = "",
         const std::string& tag = "",
@@ -68,6 +76,21 @@ public:
         int limit = 100
     ) const;
 
+    /**
+     * @brief Get every loaded question (unordered)
+     */
+    std::vector<std::shared_ptr<const Question>> get_all_questions() const;
+
+    /**
+     * @brief Replace a question's expected output (and its fingerprint)
+     *
+     * Swaps in a new instance under both keys; holders of the old one keep
+     * it unchanged. Used at startup once the reference solution has been
+     * run, before requests are served.
+     * @return false if no question has this id
+     */
+    bool set_expected_output(const std::string& id, QueryResult expected);
+
     /**
      * @brief Get all unique tags
      */
@@ -0,0 +1,125 @@
+#ifndef REQUEST_TIMING_HPP
+#define REQUEST_TIMING_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace sql_practice {
+
+/**
+ * @brief Where a request spends its time, in the order phases happen
+ */
+enum class RequestPhase : uint8_t {
+    BODY_READ,       // Reading the HTTP body
+    JSON_PARSE,      // Parsing the request JSON
+    SESSION_LOOKUP,  // Finding and touching the session
+    QUEUE_WAIT,      // Waiting for the session's earlier queries, then for a worker
+    SCHEMA_INIT,     // Switching the connection to the question's schema
+    VALIDATION,      // Parsing the SQL and checking it against the allow-list
+    EXECUTION,       // DuckDB until the first result
+    FETCH,           // Pulling and converting result chunks
+    GRADING,         // Fingerprinting and comparing with the expected output
+    SERIALIZATION    // Writing the JSON response
+};
+
+constexpr size_t REQUEST_PHASE_COUNT = 10;
+
+/**
+ * @brief Metric name of a phase as used in the Server-Timing header
+ */
+const char* request_phase_name(RequestPhase phase);
+
+/**
+ * @brief CPU time consumed by the calling thread (CLOCK_THREAD_CPUTIME_ID), in microseconds
+ */
+int64_t thread_cpu_us();
+
+/**
+ * @brief Microsecond timings of one request
+ *
+ * Phases may run on different threads (the HTTP thread and a query
+ * worker); cpu_us is the sum of the CPU time measured on each.
+ */
+struct RequestTiming {
+    std::array<int64_t, REQUEST_PHASE_COUNT> phase_us{};
+    int64_t cpu_us = 0;
+    int64_t total_us = 0;
+
+    void add(RequestPhase phase, int64_t us) { phase_us[static_cast<size_t>(phase)] += us; }
+    int64_t get(RequestPhase phase) const { return phase_us[static_cast<size_t>(phase)]; }
+
+    /**
+     * @brief Value for a Server-Timing header, e.g. "body;dur=0.012, ..., total;dur=1.204"
+     *
+     * Durations are milliseconds with microsecond precision.
+     */
+    std::string server_timing() const;
+};
+
+/**
+ * @brief Adds the wall time of a scope to one phase of a RequestTiming
+ */
+class PhaseTimer {
+private:
+    RequestTiming* timing;
+    RequestPhase phase;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    PhaseTimer(RequestTiming* request_timing, RequestPhase timed_phase)
+        : timing(request_timing), phase(timed_phase), start(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() { stop(); }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    /**
+     * @brief Record now instead of at the end of the scope
+     */
+    void stop() {
+        if (!timing) return;
+        timing->add(phase, std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start
+        ).count());
+        timing = nullptr;
+    }
+};
+
+/**
+ * @brief Process-wide totals and maxima of every recorded request
+ */
+class RequestTimingStats {
+private:
+    struct Slot {
+        std::atomic<int64_t> total_us{0};
+        std::atomic<int64_t> max_us{0};
+    };
+
+    std::atomic<uint64_t> request_count{0};
+    std::array<Slot, REQUEST_PHASE_COUNT> phases;
+    Slot cpu;
+    Slot total;
+
+    static void add(Slot& slot, int64_t us);
+
+public:
+    /**
+     * @brief Aggregates for /api/execute
+     */
+    static RequestTimingStats& shared();
+
+    void record(const RequestTiming& timing);
+
+    /**
+     * @brief {"requests":N,"phases":{"body":{"avg_us":..,"max_us":..},...},"cpu":{..},"total":{..}}
+     */
+    std::string to_json() const;
+};
+
+} // namespace sql_practice
+
+#endif // REQUEST_TIMING_HPP
@@ -0,0 +1,31 @@
+#ifndef RESOURCE_GOVERNOR_HPP
+#define RESOURCE_GOVERNOR_HPP
+
+#include <cstddef>
+
+namespace duckdb {
+struct DBConfig;
+}
+
+namespace sql_practice {
+
+/**
+ * @brief Apply Config's DuckDB resource limits to an instance configuration
+ *
+ * Config::duckdb_* are budgets for the whole server. An instance that is
+ * one of instance_count sharing them (the session pool's instances) gets
+ * memory_limit and max_temp_directory_size divided by instance_count, and
+ * an equal share of the threads (at least one). Every instance spills to
+ * its own subdirectory of the temp directory (inst_<n>, n unique in the
+ * process), so concurrent instances never share spill files. An empty
+ * memory or temp size keeps DuckDB's default; threads 0 budgets one per
+ * hardware thread. These are instance-wide settings, so they are applied
+ * when an instance is created rather than per connection.
+ *
+ * @throws duckdb::Exception if a configured value is invalid
+ */
+void apply_resource_limits(duckdb::DBConfig& config, size_t instance_count = 1);
+
+} // namespace sql_practice
+
+#endif // RESOURCE_GOVERNOR_HPP
@@ -0,0 +1,102 @@
+#ifndef RESULT_FINGERPRINT_HPP
+#define RESULT_FINGERPRINT_HPP
+
+#include "sql_executor.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sql_practice {
+
+/**
+ * @brief Order-independent summary of a result's rows
+ *
+ * Each row hashes its cells in column order into two independent 64-bit
+ * lanes (CanonicalCell::hash and alt_hash); each lane's row hashes are
+ * summed (mod 2^64), so row order does not matter and duplicate rows
+ * count once each. Cells hash by CanonicalCell, the same value
+ * grade_result compares. With 128 bits a wrong result matches only by a
+ * negligible accident, so a match is accepted without comparing rows.
+ */
+struct ResultFingerprint {
+    uint64_t row_hash_sum = 0;
+    uint64_t row_hash_sum_alt = 0;
+    uint64_t row_count = 0;
+
+    bool operator==(const ResultFingerprint& other) const {
+        return row_hash_sum == other.row_hash_sum && row_hash_sum_alt == other.row_hash_sum_alt &&
+               row_count == other.row_count;
+    }
+    bool operator!=(const ResultFingerprint& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Fingerprint of a materialized result (e.g. a question's expected output)
+ */
+ResultFingerprint fingerprint_result(const QueryResult& result);
+
+/**
+ * @brief Hashes rows while DuckDBConnection::execute streams them
+ *
+ * Forwards chunks to the downstream sink (when given) until it stops
+ * accepting rows, and fingerprints every row straight from the DuckDB
+ * vectors. Rows past the downstream's budget are still hashed, so a
+ * response truncated for size is graded in full. Once more than
+ * row_limit rows have arrived the result cannot match: hashing stops,
+ * and the fetch ends as soon as the downstream is full.
+ *
+ * When rows is given, every hashed row is also appended to it, for
+ * ordered questions whose verdict comes from grade_result; memory stays
+ * bounded by row_limit. Unordered questions pass nullptr and are graded
+ * by the fingerprint alone.
+ */
+class FingerprintSink : public ResultChunkSink {
+public:
+    /**
+     * @brief One row's hash in both fingerprint lanes
+     */
+    struct RowHash {
+        uint64_t lane;
+        uint64_t alt_lane;
+    };
+
+private:
+    ResultChunkSink* downstream;
+    uint64_t row_limit;
+    QueryResult* rows;
+    ResultFingerprint fingerprint;
+    bool limit_exceeded;
+    bool downstream_full;
+    int64_t hash_ns;                  // Time spent hashing and collecting, for request timing
+    std::vector<RowHash> row_hashes;  // Scratch, one hash per chunk row
+
+public:
+    FingerprintSink(ResultChunkSink* downstream, uint64_t row_limit, QueryResult* rows = nullptr);
+
+    void begin(const std::vector<std::string>& columns) override;
+    size_t append(duckdb::DataChunk& chunk, size_t count, duckdb::ClientContext& context) override;
+
+    const ResultFingerprint& get_fingerprint() const { return fingerprint; }
+    bool exceeded_row_limit() const { return limit_exceeded; }
+
+    /**
+     * @brief True when the downstream sink stopped taking rows (e.g. a size cap)
+     */
+    bool downstream_truncated() const { return downstream_full; }
+    int64_t get_hash_us() const { return hash_ns / 1000; }
+
+    /**
+     * @brief True when the streamed rows hash to expected
+     *
+     * Row count and both 64-bit lanes must match. For an unordered
+     * question this is the verdict; an ordered one still needs
+     * grade_result on the collected rows to check their order.
+     */
+    bool matches(const ResultFingerprint& expected) const {
+        return !limit_exceeded && fingerprint == expected;
+    }
+};
+
+} // namespace sql_practice
+
+#endif // RESULT_FINGERPRINT_HPP
@@ -0,0 +1,38 @@
+#ifndef RESULT_GRADER_HPP
+#define RESULT_GRADER_HPP
+
+#include "sql_executor.hpp"
+#include <cstdint>
+#include <string>
+
+namespace sql_practice {
+
+/**
+ * @brief How a question compares the student's rows with the expected rows
+ */
+enum class GradeMode : uint8_t {
+    UNORDERED,  // Rows compared as a multiset; duplicates must match in number
+    ORDERED     // Row i must equal expected row i
+};
+
+/**
+ * @brief GradeMode for a question's "grading" name ("ordered" / "unordered")
+ *
+ * Anything other than "ordered" grades unordered.
+ */
+GradeMode grade_mode_from(const std::string& name);
+
+/**
+ * @brief Grade a student result against a question's expected output
+ *
+ * Column names and row count must match first. ORDERED walks both results
+ * in step and stops at the first differing row. UNORDERED buckets the
+ * expected rows by ResultColumn::hash and removes one equal row per actual
+ * row, so grading stays linear in the row count. A truncated result never
+ * matches.
+ */
+bool grade_result(const QueryResult& actual, const QueryResult& expected, GradeMode mode);
+
+} // namespace sql_practice
+
+#endif // RESULT_GRADER_HPP
@@ -0,0 +1,64 @@
+#ifndef RESULT_JSON_WRITER_HPP
+#define RESULT_JSON_WRITER_HPP
+
+#include "include/sql_executor.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sql_practice {
+
+/**
+ * @brief Serializes a streaming query result straight from DuckDB chunks
+ *
+ * Writes {"columns":[...],"rows":[[...],...] into one growable buffer,
+ * one array per row in column order, followed by any fields added with
+ * write_field(). Numbers and booleans are unquoted, NULL is null, and
+ * everything else (including non-finite doubles) is an escaped string.
+ *
+ * The finished buffer is moved out with release(), so it can be handed to
+ * oatpp::String without a copy. The size of each released buffer is kept
+ * per thread and used to pre-size the next one.
+ */
+class ResultJsonWriter : public ResultChunkSink {
+private:
+    std::string buffer;
+    size_t max_bytes;     // Budget for the rows array (0 = unlimited)
+    size_t max_rows;      // Rows written at most (0 = unlimited)
+    size_t rows_start;    // Offset of the first row in buffer
+    size_t rows_written;
+    bool rows_open;
+
+    void close_rows();
+    void begin_field(const char* name);  // Field names are written unescaped
+
+public:
+    explicit ResultJsonWriter(size_t max_bytes = 0, size_t max_rows = 0);
+
+    void begin(const std::vector<std::string>& columns) override;
+
+    /**
+     * @brief Append rows until the chunk is done, max_rows are written or
+     * max_bytes would be exceeded
+     */
+    size_t append(duckdb::DataChunk& chunk, size_t count, duckdb::ClientContext& context) override;
+
+    void write_field(const char* name, bool value);
+    void write_field(const char* name, int64_t value);
+
+    size_t get_rows_written() const { return rows_written; }
+
+    /**
+     * @brief Close the JSON object and move the buffer out
+     */
+    std::string release();
+
+    /**
+     * @brief Append s to out as a quoted, escaped JSON string
+     */
+    static void append_escaped(std::string& out, const char* s, size_t len);
+};
+
+} // namespace sql_practice
+
+#endif // RESULT_JSON_WRITER_HPP
@@ -0,0 +1,75 @@
+#ifndef SESSION_INDEX_HPP
+#define SESSION_INDEX_HPP
+
+#include "session_token.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace sql_practice {
+
+struct UserSession;
+
+/**
+ * @brief Flat open-addressing map from SessionToken to session
+ *
+ * Keys live inline in a power-of-two slot array (32 bytes per slot, two
+ * per cache line) probed linearly from the token's low bits; an all-zero
+ * key marks an empty slot. Removal shifts later entries of the probe run
+ * back instead of leaving tombstones, so lookups stay short after churn.
+ * The table grows at 75% load. Not thread-safe; SessionManager holds one
+ * per shard under the shard's lock.
+ */
+class SessionIndex {
+private:
+    struct Slot {
+        SessionToken key;
+        std::shared_ptr<UserSession> session;
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+    size_t count;
+
+    size_t home(const SessionToken& token) const {
+        // Tokens are uniformly random; mix hi in anyway so crafted values spread
+        return static_cast<size_t>(token.lo ^ (token.hi * 0x9E3779B97F4A7C15ULL)) & mask;
+    }
+
+    void grow();
+
+public:
+    explicit SessionIndex(size_t initial_capacity = 64);
+
+    /**
+     * @brief Session for a token, or nullptr
+     */
+    std::shared_ptr<UserSession> find(const SessionToken& token) const;
+
+    /**
+     * @brief Insert or replace; token must not be empty
+     */
+    void insert(const SessionToken& token, std::shared_ptr<UserSession> session);
+
+    /**
+     * @brief Remove and return a session (nullptr if absent)
+     */
+    std::shared_ptr<UserSession> erase(const SessionToken& token);
+
+    /**
+     * @brief Visit every (token, session) pair
+     */
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        for (const auto& slot : slots) {
+            if (!slot.key.empty()) fn(slot.key, slot.session);
+        }
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+};
+
+} // namespace sql_practice
+
+#endif // SESSION_INDEX_HPP
@@ -4,10 +4,19 @@
 #include <string>
 #include <unordered_map>
 #include <shared_mutex>
+#include <mutex>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <thread>
 #include <vector>
+#include <atomic>
 #include "sql_executor.hpp"
+#include "instance_pool.hpp"
+#include "session_index.hpp"
+#include "session_token.hpp"
+#include "expiry_wheel.hpp"
+#include "session_reaper.hpp"
 
 namespace sql_practice {
 
@@ -18,70 +27,164 @@ namespace sql_practice {
  */
 struct UserSession {
     std::string user_id;
-    std::string session_token;
+    SessionToken token;
     std::unique_ptr<DuckDBConnection> db_conn;
-    std::chrono::steady_clock::time_point last_activity;
+    std::atomic<std::chrono::steady_clock::rep> last_activity;  // steady_clock ticks; read by the expiry thread
     int query_count;
-    std::string current_question_id;  // Track which question's schema is loaded
+    std::string current_question_id;  // Track which question's schema is active
+    std::mutex query_mutex;  // Serializes schema switches and queries on db_conn
+    std::atomic<bool> schema_modified{false};  // Ran a non-read-only statement; grades bypass the cache
 
-    UserSession(const std::string& uid, const std::string& token)
-        : user_id(uid), session_token(token), query_count(0), current_question_id("") {
-        last_activity = std::chrono::steady_clock::now();
+    UserSession(const std::string& uid, const SessionToken& session_token)
+        : user_id(uid), token(session_token),
+          last_activity(std::chrono::steady_clock::now().time_since_epoch().count()),
+          query_count(0), current_question_id("") {
+    }
+
+    std::chrono::steady_clock::time_point get_last_activity() const {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(last_activity.load(std::memory_order_relaxed)));
     }
 
     bool is_expired(int timeout_seconds = 120) const {
         auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - last_activity);
+        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - get_last_activity());
         return elapsed.count() > timeout_seconds;
     }
 
+    /**
+     * @brief Stamp activity; O(1) and lock-free, the expiry timer re-arms itself lazily
+     */
     void update_activity() {
-        last_activity = std::chrono::steady_clock::now();
+        last_activity.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                            std::memory_order_relaxed);
     }
 };
 
 /**
  * @brief Manages all active user sessions
  *
- * Thread-safe session management with automatic cleanup
+ * Thread-safe session management with automatic cleanup. The table is
+ * split into a power-of-two number of shards picked by the token's high
+ * bits, each on its own cache line with its own lock and SessionIndex, so
+ * lookups, logins and cleanup on different shards never contend.
+ *
+ * Expiry is driven by an ExpiryWheel serviced by one background thread
+ * once a second. Each session has a single wheel entry armed at login for
+ * last_activity + timeout. When it fires, the session is removed if it is
+ * still idle, or re-armed from its current last_activity otherwise, so
+ * requests never touch the wheel and idle sessions cost nothing until
+ * their deadline.
+ *
+ * Removed sessions are handed to a SessionReaper, so their DuckDB
+ * connections are torn down on its background thread rather than under a
+ * shard lock or on a request thread.
  */
 class SessionManager {
 private:
-    std::unordered_map<std::string, std::shared_ptr<UserSession>> sessions;
-    mutable std::shared_mutex sessions_mutex;
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        SessionIndex sessions;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shard_mask;                      // shard count - 1
+    std::atomic<size_t> session_count{0};
     int session_timeout_seconds;
+    std::shared_ptr<DuckDBInstancePool> instance_pool;
+
+    std::chrono::steady_clock::time_point expiry_epoch;  // Tick 0 of the wheel
+    ExpiryWheel expiry_wheel;
+    std::mutex expiry_mutex;  // Guards expiry_wheel and expiry_stopping
+    std::condition_variable expiry_cv;
+    bool expiry_stopping;
+    std::thread expiry_thread;
+
+    // Declared last so it is drained first on destruction
+    SessionReaper reaper;
+
+    Shard& shard_for(const SessionToken& token) const {
+        return shards[static_cast<size_t>(token.hi) & shard_mask];
+    }
+
+    /**
+     * @brief First wheel tick at which a session idle since last_activity is expired
+     */
+    uint64_t expiry_tick_for(std::chrono::steady_clock::time_point last_activity) const;
+
+    void arm_expiry(const SessionToken& token, std::chrono::steady_clock::time_point last_activity);
+
+    /**
+     * @brief Advance the wheel to now_tick; remove idle sessions and re-arm active ones
+     */
+    size_t expire_due(uint64_t now_tick);
+
+    void expiry_loop();
 
 public:
-    explicit SessionManager(int timeout_sec = 120)
-        : session_timeout_seconds(timeout_sec) {}
+    static constexpr size_t DEFAULT_SHARDS = 64;
+
+    /**
+     * @brief Instance pool is sized from Config::max_concurrent_sessions and
+     * Config::connections_per_instance
+     *
+     * @param shard_count Rounded up to a power of two (1 = a single global lock)
+     */
+    explicit SessionManager(int timeout_sec = 120, size_t shard_count = DEFAULT_SHARDS);
+
+    /**
+     * @brief Stops the expiry thread
+     */
+    ~SessionManager();
+
+    SessionManager(const SessionManager&) = delete;
+    SessionManager& operator=(const SessionManager&) = delete;
 
     /**
      * @brief Create a new session for a user
+     *
+     * @return Token in wire form ("sess_" + 32 hex digits)
      */
     std::string create_session(const std::string& user_id);
 
     /**
-     * @brief Get session by token (thread-safe)
+     * @brief Get session by decoded token (thread-safe)
      */
-    std::shared_ptr<UserSession> get_session(const std::string& token);
+    std::shared_ptr<UserSession> get_session(const SessionToken& token) const;
 
     /**
-     * @brief Remove expired sessions (should be called periodically)
+     * @brief Get session by wire-form token; malformed tokens return nullptr
+     * without touching the table
      */
-    size_t cleanup_expired();
+    std::shared_ptr<UserSession> get_session(std::string_view token) const;
 
     /**
      * @brief Get current active session count
      */
     size_t get_active_count() const {
-        std::shared_lock lock(sessions_mutex);
-        return sessions.size();
+        return session_count.load(std::memory_order_relaxed);
     }
 
     /**
      * @brief Terminate a specific session
      */
-    void terminate_session(const std::string& token);
+    void terminate_session(const SessionToken& token);
+
+    /**
+     * @brief Shared DuckDB instances backing session connections
+     */
+    std::shared_ptr<DuckDBInstancePool> get_instance_pool() const {
+        return instance_pool;
+    }
+
+    size_t get_shard_count() const { return shard_mask + 1; }
+
+    /**
+     * @brief Removed sessions not yet destroyed by the reaper
+     */
+    size_t get_reaper_backlog() const { return reaper.get_backlog(); }
+
+    uint64_t get_reaped_count() const { return reaper.get_reaped_count(); }
 };
 
 } // namespace sql_practice
@@ -0,0 +1,64 @@
+#ifndef SESSION_REAPER_HPP
+#define SESSION_REAPER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sql_practice {
+
+struct UserSession;
+
+/**
+ * @brief Destroys removed sessions on a low-priority background thread
+ *
+ * Dropping a session closes its DuckDB connection and may tear down
+ * buffers and threads, so SessionManager removes sessions from its table
+ * under the shard lock but hands the last reference here. The reaper
+ * takes everything queued in one swap and releases it off every lock and
+ * request thread. A session still used by an in-flight request is freed
+ * by that request when it finishes.
+ */
+class SessionReaper {
+private:
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::vector<std::shared_ptr<UserSession>> queue;
+    bool stopping;
+
+    std::atomic<size_t> backlog;   // Queued plus currently being destroyed
+    std::atomic<uint64_t> reaped;
+    std::thread worker;
+
+    void run();
+
+public:
+    SessionReaper();
+
+    /**
+     * @brief Destroys anything still queued before returning
+     */
+    ~SessionReaper();
+
+    SessionReaper(const SessionReaper&) = delete;
+    SessionReaper& operator=(const SessionReaper&) = delete;
+
+    void enqueue(std::shared_ptr<UserSession> session);
+    void enqueue(std::vector<std::shared_ptr<UserSession>> sessions);
+
+    /**
+     * @brief Sessions handed over but not yet destroyed
+     */
+    size_t get_backlog() const { return backlog.load(std::memory_order_relaxed); }
+
+    uint64_t get_reaped_count() const { return reaped.load(std::memory_order_relaxed); }
+};
+
+} // namespace sql_practice
+
+#endif // SESSION_REAPER_HPP
@@ -0,0 +1,46 @@
+#ifndef SESSION_TOKEN_HPP
+#define SESSION_TOKEN_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace sql_practice {
+
+/**
+ * @brief Session token as 128 bits
+ *
+ * The wire form is "sess_" followed by 32 lowercase hex digits (hi first).
+ * Tokens are decoded once at the HTTP edge; inside the server they are
+ * compared and hashed as two integers. The all-zero token is reserved as
+ * the empty-slot marker of SessionIndex and is never issued or accepted.
+ */
+struct SessionToken {
+    static constexpr std::string_view PREFIX = "sess_";
+    static constexpr size_t HEX_DIGITS = 32;
+    static constexpr size_t WIRE_LENGTH = 5 + HEX_DIGITS;
+
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+
+    bool empty() const { return (hi | lo) == 0; }
+    bool operator==(const SessionToken& other) const { return hi == other.hi && lo == other.lo; }
+    bool operator!=(const SessionToken& other) const { return !(*this == other); }
+
+    /**
+     * @brief Decode the wire form; nullopt for anything malformed or all-zero
+     *
+     * Length and prefix are checked before any digit is decoded.
+     */
+    static std::optional<SessionToken> parse(std::string_view text);
+
+    /**
+     * @brief Wire form ("sess_" + 32 hex digits)
+     */
+    std::string to_string() const;
+};
+
+} // namespace sql_practice
+
+#endif // SESSION_TOKEN_HPP
@@ -0,0 +1,60 @@
+#ifndef SOLUTION_RUNNER_HPP
+#define SOLUTION_RUNNER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sql_practice {
+
+class QuestionLoader;
+class FixtureCatalog;
+
+/**
+ * @brief Outcome of running one question's reference solution
+ */
+struct SolutionRun {
+    std::string question_id;
+    bool skipped = false;     // Question has no solution; its hand-written output is kept
+    bool succeeded = false;   // Solution ran and agreed with the hand-written output (if any)
+    int64_t elapsed_us = 0;   // Fixture switch + parse + execution
+    int row_count = 0;
+    bool over_response_caps = false;  // Output exceeds the question's execute-path row or byte cap
+    std::string error;        // Why the run failed, empty on success
+};
+
+/**
+ * @brief Timings of the startup expected-output stage
+ */
+struct SolutionReport {
+    std::vector<SolutionRun> runs;  // Sorted by question id; runs never started after a failure are absent
+    size_t worker_count = 0;        // Workers that actually ran, the calling thread included if it helped
+    int64_t elapsed_ms = 0;
+    size_t derived = 0;             // Questions whose expected output now comes from the solution
+
+    /**
+     * @brief Runs whose output a correct answer's response cannot show in full
+     */
+    std::vector<const SolutionRun*> over_response_caps() const;
+};
+
+/**
+ * @brief Run every reference solution and make its output the expected output
+ *
+ * Solutions run on worker_count workers (0 = one per hardware thread), each
+ * with its own connection on a shared DuckDB instance that attaches the
+ * fixture catalog, exactly as student sessions see it. A question's
+ * hand-written expected rows, when present, must match the solution's
+ * output under the question's grade mode; the typed result then replaces
+ * them in loader. Outputs larger than SQLExecutor::limits_for() allows in a
+ * response are flagged (SolutionRun::over_response_caps), not rejected.
+ *
+ * @throws std::runtime_error on the first solution that fails or disagrees;
+ *         workers stop taking questions as soon as one does
+ */
+SolutionReport derive_expected_outputs(QuestionLoader& loader, const FixtureCatalog& catalog,
+                                       size_t worker_count);
+
+} // namespace sql_practice
+
+#endif // SOLUTION_RUNNER_HPP
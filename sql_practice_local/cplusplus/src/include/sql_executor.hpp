@@ -2,14 +2,143 @@
 #define SQL_EXECUTOR_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
+#include <list>
 #include <memory>
+#include <optional>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include "canonical_cell.hpp"
+
+namespace duckdb {
+class DataChunk;
+class ClientContext;
+class QueryResult;
+}
 
 namespace sql_practice {
 
+class DuckDBInstancePool;
+
+/**
+ * @brief Storage class of a result column
+ */
+enum class ColumnKind : uint8_t {
+    BOOLEAN,  // Stored in ints as 0/1
+    INTEGER,  // All signed and unsigned integers up to 64 bits, stored in ints
+    DOUBLE,   // FLOAT and DOUBLE, stored in doubles
+    TEXT      // VARCHAR and every other type in its text form, stored in strings
+};
+
+/**
+ * @brief One column of a query result, stored column-major
+ *
+ * Only the value vector matching kind is used. NULL cells still occupy a
+ * slot (zero / empty) so row indexes line up; validity has bit i set when
+ * row i is non-NULL.
+ */
+struct ResultColumn {
+    ColumnKind kind = ColumnKind::TEXT;
+    std::vector<int64_t> ints;
+    std::vector<double> doubles;
+    std::vector<std::string> strings;
+    std::vector<uint64_t> validity;
+    size_t count = 0;
+
+    explicit ResultColumn(ColumnKind k = ColumnKind::TEXT) : kind(k) {}
+
+    size_t size() const { return count; }
+
+    bool is_null(size_t row) const {
+        return (validity[row >> 6] & (uint64_t(1) << (row & 63))) == 0;
+    }
+
+    void reserve(size_t rows) {
+        validity.reserve((rows + 63) / 64);
+        switch (kind) {
+            case ColumnKind::BOOLEAN:
+            case ColumnKind::INTEGER: ints.reserve(rows); break;
+            case ColumnKind::DOUBLE: doubles.reserve(rows); break;
+            case ColumnKind::TEXT: strings.reserve(rows); break;
+        }
+    }
+
+    void append_null() {
+        switch (kind) {
+            case ColumnKind::BOOLEAN:
+            case ColumnKind::INTEGER: ints.push_back(0); break;
+            case ColumnKind::DOUBLE: doubles.push_back(0.0); break;
+            case ColumnKind::TEXT: strings.emplace_back(); break;
+        }
+        mark(false);
+    }
+
+    /**
+     * @brief Drop every row from rows onwards
+     */
+    void truncate(size_t rows) {
+        if (rows >= count) return;
+        ints.resize(std::min(ints.size(), rows));
+        doubles.resize(std::min(doubles.size(), rows));
+        strings.resize(std::min(strings.size(), rows));
+        validity.resize((rows + 63) / 64);
+        if (rows & 63) validity.back() &= (uint64_t(1) << (rows & 63)) - 1;
+        count = rows;
+    }
+
+    void append_int(int64_t value) { ints.push_back(value); mark(true); }
+    void append_double(double value) { doubles.push_back(value); mark(true); }
+    void append_text(std::string value) { strings.push_back(std::move(value)); mark(true); }
+
+    /**
+     * @brief Text form of a cell, "NULL" for NULL (used for display)
+     */
+    std::string to_string(size_t row) const;
+
+    /**
+     * @brief The value grading compares; TEXT cells point into this column
+     */
+    CanonicalCell canonical(size_t row) const {
+        if (is_null(row)) return CanonicalCell::null();
+        switch (kind) {
+            case ColumnKind::BOOLEAN: return CanonicalCell::from_bool(ints[row] != 0);
+            case ColumnKind::INTEGER: return CanonicalCell::from_int(ints[row]);
+            case ColumnKind::DOUBLE: return CanonicalCell::from_double(doubles[row]);
+            case ColumnKind::TEXT: return CanonicalCell::from_text(strings[row].data(), strings[row].size());
+        }
+        return CanonicalCell::null();
+    }
+
+    /**
+     * @brief Compare two cells by their canonical values
+     */
+    bool cell_equals(size_t row, const ResultColumn& other, size_t other_row) const {
+        return canonical(row) == other.canonical(other_row);
+    }
+
+    /**
+     * @brief Hash of a cell, equal whenever cell_equals holds
+     */
+    uint64_t hash(size_t row) const { return canonical(row).hash(); }
+
+private:
+    std::string_view text(size_t row, char (&buffer)[32]) const;
+
+    void mark(bool valid) {
+        if ((count & 63) == 0) validity.push_back(0);
+        if (valid) validity.back() |= uint64_t(1) << (count & 63);
+        count++;
+    }
+};
+
 /**
  * @brief Result of SQL query execution
+ *
+ * Column-major: names are stored once in columns, values in data (one
+ * ResultColumn per name, each holding row_count cells).
  */
 struct QueryResult {
     bool success;
@@ -17,17 +146,73 @@ struct QueryResult {
 
     // Output data
     std::vector<std::string> columns;
-    std::vector<std::unordered_map<std::string, std::string>> rows;
+    std::vector<ResultColumn> data;
 
     // Execution metrics
     int64_t execution_time_ms;
+    int64_t execute_us;  // Until the first result is available (parse, plan, start)
+    int64_t fetch_us;    // Pulling and converting chunks, excluding the sink
+    int64_t sink_us;     // Time spent inside ResultChunkSink calls
     int row_count;
+    bool truncated;  // Fetch stopped at a row or byte limit
+    bool timed_out;  // Interrupted by the query watchdog
 
     // Comparison with expected output
     bool is_correct;
 
     QueryResult()
-        : success(false), execution_time_ms(0), row_count(0), is_correct(false) {}
+        : success(false), execution_time_ms(0), execute_us(0), fetch_us(0), sink_us(0), row_count(0),
+          truncated(false), timed_out(false), is_correct(false) {}
+
+    /**
+     * @brief True if row equals other_row of other in every column
+     */
+    bool row_equals(size_t row, const QueryResult& other, size_t other_row) const;
+};
+
+/**
+ * @brief Append the first count rows of a streamed chunk to result
+ *
+ * Converts cells the way a materialized execute() does. The columns of
+ * data are created from the chunk's types on the first call.
+ */
+void append_chunk_rows(QueryResult& result, duckdb::DataChunk& chunk, size_t count,
+                       duckdb::ClientContext& context);
+
+/**
+ * @brief Caps on how much of a result is fetched and how long it may run
+ * (0 = unlimited)
+ *
+ * Bytes count the text of VARCHAR-like cells and 8 per numeric cell.
+ */
+struct ResultLimits {
+    size_t max_rows = 0;
+    size_t max_bytes = 0;
+    int timeout_ms = 0;
+};
+
+/**
+ * @brief Receives each fetched chunk while DuckDBConnection::execute streams
+ *
+ * Lets a consumer (e.g. the JSON response writer) read DuckDB vectors
+ * directly instead of going through QueryResult.
+ */
+class ResultChunkSink {
+public:
+    virtual ~ResultChunkSink() = default;
+
+    /**
+     * @brief Called once with the result's column names, before any chunk
+     */
+    virtual void begin(const std::vector<std::string>& columns) = 0;
+
+    /**
+     * @brief Consume the first count rows of chunk
+     *
+     * @return Rows accepted from the front of the chunk; fewer than count
+     *         stops the fetch and marks the result truncated
+     */
+    virtual size_t append(duckdb::DataChunk& chunk, size_t count, duckdb::ClientContext& context) = 0;
 };
 
 /**
@@ -48,6 +233,66 @@ struct QuestionSchema {
     std::unordered_map<std::string, std::vector<std::unordered_map<std::string, std::string>>> sample_data;
 };
 
+/**
+ * @brief Bounded most-recently-used set of question schemas on a connection
+ *
+ * Each question a session visits gets its own schema in the session
+ * catalog; the LRU decides which ones stay loaded.
+ */
+class QuestionSchemaLRU {
+private:
+    size_t capacity;
+    std::list<std::string> order;  // Front = most recently used
+    std::unordered_map<std::string, std::list<std::string>::iterator> index;
+
+public:
+    explicit QuestionSchemaLRU(size_t max_schemas);
+
+    /**
+     * @brief Mark a schema as used; returns false if it is not loaded
+     */
+    bool touch(const std::string& schema_name);
+
+    /**
+     * @brief Record a newly loaded schema
+     * @return The least recently used schema if capacity was exceeded
+     */
+    std::optional<std::string> insert(const std::string& schema_name);
+
+    size_t size() const { return order.size(); }
+};
+
+/**
+ * @brief A student query parsed once by SQLExecutor::validate
+ *
+ * Holds DuckDB's parsed statements so execution does not parse the SQL a
+ * second time. error_message is set when the SQL does not parse or uses a
+ * statement type outside the question's allow-list.
+ */
+struct ParsedQuery {
+    struct Statements;  // DuckDB's statement list, defined alongside DuckDBConnection
+    std::unique_ptr<Statements> statements;
+    std::string error_message;
+
+    ParsedQuery();
+    ParsedQuery(ParsedQuery&&) noexcept;
+    ParsedQuery& operator=(ParsedQuery&&) noexcept;
+    ~ParsedQuery();
+
+    size_t statement_count() const;
+
+    /**
+     * @brief True when every statement is a SELECT
+     */
+    bool read_only() const;
+
+    /**
+     * @brief Source text of the query when it is a single SELECT, otherwise empty
+     */
+    std::string select_sql() const;
+    bool is_valid() const { return error_message.empty(); }
+};
+
 /**
  * @brief SQL Executor using DuckDB
  *
@@ -56,25 +301,66 @@ struct QuestionSchema {
 class SQLExecutor {
 private:
     std::string shared_db_path;
+    std::shared_ptr<DuckDBInstancePool> instance_pool;
 
 public:
     explicit SQLExecutor(const std::string& db_path = ":memory:");
+    explicit SQLExecutor(std::shared_ptr<DuckDBInstancePool> pool);
 
     /**
      * @brief Create a new isolated database connection for a session
+     *
+     * With an instance pool the connection is opened on the least-loaded
+     * shared instance; otherwise a private instance is created.
      */
     std::unique_ptr<class DuckDBConnection> create_connection();
 
     /**
      * @brief Initialize database schema for a question
+     *
+     * Creates each table and bulk-loads its sample rows with a DuckDB
+     * Appender, typed from QuestionSchema::Column::type. Tables go into
+     * schema_name when given, otherwise into the connection's default schema.
      */
     bool initialize_schema(
         DuckDBConnection* conn,
-        const QuestionSchema& schema
+        const QuestionSchema& schema,
+        const std::string& schema_name = ""
+    );
+
+    /**
+     * @brief Switch a session connection to a question's tables
+     *
+     * Each question lives in its own schema of the session catalog, holding
+     * views onto the shared read-only fixture catalog (or a private copy via
+     * initialize_schema when the fixture catalog is unavailable). Switching
+     * sets search_path; schemas still in the connection's LRU are reused
+     * without any re-initialization. writable questions (see modifies_tables)
+     * always get a private copy, since views onto the fixture catalog
+     * cannot be modified.
+     */
+    bool load_question_fixture(
+        DuckDBConnection* conn,
+        const std::string& question_id,
+        const QuestionSchema& schema,
+        bool writable = false
     );
 
     /**
-     * @brief Execute SQL query
+     * @brief True if an allow-list admits statements that change table data
+     */
+    static bool modifies_tables(const std::vector<std::string>& allowed_statements);
+
+    /**
+     * @brief Limits for a student query on a question of this difficulty
+     *
+     * Config::max_result_rows / Config::max_result_bytes and
+     * Config::query_timeout_for(difficulty).
+     */
+    static ResultLimits limits_for(const std::string& difficulty = "");
+
+    /**
+     * @brief Execute a student query under limits_for()
      */
     QueryResult execute(
         DuckDBConnection* conn,
@@ -82,34 +368,156 @@ public:
     );
 
     /**
-     * @brief Compare result with expected output
+     * @brief Execute a student query, streaming chunks into sink
+     *
+     * The byte cap is left to the sink. With materialize false the returned
+     * QueryResult carries only status, columns, row_count, truncated and
+     * timed_out.
      */
-    bool compare_results(
-        const QueryResult& result,
-        const std::vector<std::unordered_map<std::string, std::string>>& expected
-    ) const;
+    QueryResult execute(
+        DuckDBConnection* conn,
+        const std::string& sql,
+        const ResultLimits& limits,
+        ResultChunkSink* sink,
+        bool materialize
+    );
 
     /**
-     * @brief Validate SQL safety (check for dangerous keywords)
+     * @brief Execute a query already parsed by validate()
      */
-    bool is_safe_query(const std::string& sql) const;
+    QueryResult execute(
+        DuckDBConnection* conn,
+        ParsedQuery&& query,
+        const ResultLimits& limits,
+        ResultChunkSink* sink,
+        bool materialize
+    );
+
+    /**
+     * @brief Run a parsed query with DuckDB's profiler and return its operator tree
+     *
+     * Every row is fetched and discarded (no row or byte cap, so the
+     * profile covers the whole query); limits.timeout_ms still applies.
+     * profile_json receives DuckDB's JSON profile of the last statement,
+     * with per-operator timings and cardinalities. The returned result
+     * carries status, columns and row_count only.
+     */
+    QueryResult explain_analyze(
+        DuckDBConnection* conn,
+        ParsedQuery&& query,
+        const ResultLimits& limits,
+        std::string& profile_json
+    );
+
+    /**
+     * @brief Parse a student query with DuckDB's parser and check its statements
+     *
+     * allowed_statements names the statement types the question permits
+     * (SELECT, INSERT, UPDATE, DELETE, CREATE, DROP, ALTER, EXPLAIN, ...);
+     * an empty list allows SELECT only. SQL naming another session's
+     * catalog, the fixtures catalog, a "__"-prefixed object or catalog
+     * metadata (duckdb_tables(), information_schema, SHOW ALL TABLES, ...)
+     * is rejected as well. The returned statements are meant
+     * to be handed to execute() so the SQL is parsed once per request.
+     */
+    ParsedQuery validate(
+        DuckDBConnection* conn,
+        const std::string& sql,
+        const std::vector<std::string>& allowed_statements
+    ) const;
 };
 
 /**
  * @brief DuckDB connection wrapper
+ *
+ * Either owns a private DuckDB instance, or holds a lease on a shared
+ * instance from DuckDBInstancePool. Pooled connections are isolated from
+ * each other by a per-session in-memory catalog attached on the shared
+ * instance and selected with USE.
  */
 class DuckDBConnection {
 private:
-    void* db;  // duckdb::Database
+    void* db;  // duckdb::Database (owned only for private instances)
     void* conn;  // duckdb::Connection
 
+    std::shared_ptr<DuckDBInstancePool> pool;
+    size_t instance_id;
+    std::string catalog_name;  // Per-session catalog on a shared instance
+    bool fixtures_attached;    // Shared read-only fixture catalog is reachable
+    QuestionSchemaLRU question_schemas;
+
+    QueryResult run_guarded(
+        const std::function<std::unique_ptr<duckdb::QueryResult>()>& start_query,
+        const ResultLimits& limits,
+        ResultChunkSink* sink,
+        bool materialize
+    );
+
+    QueryResult stream_query(
+        const std::function<std::unique_ptr<duckdb::QueryResult>()>& start_query,
+        const ResultLimits& limits,
+        ResultChunkSink* sink,
+        bool materialize
+    );
+
 public:
     DuckDBConnection(const std::string& path);
+    explicit DuckDBConnection(std::shared_ptr<DuckDBInstancePool> instance_pool);
     ~DuckDBConnection();
 
-    QueryResult execute(const std::string& sql);
+    DuckDBConnection(const DuckDBConnection&) = delete;
+    DuckDBConnection& operator=(const DuckDBConnection&) = delete;
+
+    /**
+     * @brief Execute SQL and stream the result until done or a limit is hit
+     *
+     * Each chunk is passed to sink when given, and copied into the result's
+     * columns when materialize is set. limits.max_bytes is only enforced
+     * here without a sink; a sink applies its own byte budget. A query
+     * still running after limits.timeout_ms is interrupted by the
+     * QueryWatchdog and fails with timed_out set.
+     */
+    QueryResult execute(
+        const std::string& sql,
+        const ResultLimits& limits = ResultLimits(),
+        ResultChunkSink* sink = nullptr,
+        bool materialize = true
+    );
+
+    /**
+     * @brief Parse SQL into statements without executing it
+     *
+     * Parser errors are returned in ParsedQuery::error_message.
+     */
+    ParsedQuery parse(const std::string& sql);
+
+    /**
+     * @brief Execute pre-parsed statements under the same limits as execute()
+     *
+     * All statements but the last run to completion; the last one is
+     * streamed like execute(). When any statement is not a SELECT, the
+     * whole query runs in a transaction that is rolled back afterwards, so
+     * every submission starts from the same tables. query.statements is
+     * consumed.
+     *
+     * on_success, when given, runs after the last statement succeeds and
+     * before that rollback, while the connection still reflects it (its
+     * profile, for one: the ROLLBACK would replace it).
+     */
+    QueryResult execute(
+        ParsedQuery&& query,
+        const ResultLimits& limits = ResultLimits(),
+        ResultChunkSink* sink = nullptr,
+        bool materialize = true,
+        const std::function<void(QueryResult&)>& on_success = nullptr
+    );
 
     void* get_connection() const { return conn; }
+    bool is_pooled() const { return pool != nullptr; }
+    size_t get_instance_id() const { return instance_id; }
+    const std::string& get_catalog_name() const { return catalog_name; }
+    bool has_fixture_catalog() const { return fixtures_attached; }
+    QuestionSchemaLRU& get_question_schemas() { return question_schemas; }
 };
 
 } // namespace sql_practice
@@ -0,0 +1,32 @@
+#ifndef SQL_NORMALIZER_HPP
+#define SQL_NORMALIZER_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace sql_practice {
+
+/**
+ * @brief Canonical form of a submitted query, used as a cache key
+ */
+struct NormalizedSQL {
+    std::string text;     // Comments removed, whitespace collapsed, keywords upper-cased
+    uint64_t hash;        // FNV-1a of text
+    bool read_only;       // A single SELECT / WITH / VALUES / FROM statement without DDL or DML
+    bool deterministic;   // No volatile functions and no references to session catalogs
+};
+
+/**
+ * @brief Canonicalize whitespace, keyword case and comments
+ *
+ * String literals and quoted identifiers are kept verbatim. Only SQL
+ * keywords are upper-cased: unquoted identifiers keep their spelling
+ * because DuckDB uses it for result column names. A space is kept only
+ * where it separates two words or two operator characters; trailing
+ * semicolons and comments are dropped.
+ */
+NormalizedSQL normalize_sql(const std::string& sql);
+
+} // namespace sql_practice
+
+#endif // SQL_NORMALIZER_HPP
@@ -0,0 +1,28 @@
+#ifndef TOKEN_GENERATOR_HPP
+#define TOKEN_GENERATOR_HPP
+
+#include "session_token.hpp"
+
+namespace sql_practice {
+
+/**
+ * @brief Session token source backed by the kernel CSPRNG
+ *
+ * Each thread keeps a 4 KiB buffer filled by one getrandom() call and
+ * hands out 16 bytes per token, so a login costs a buffer read instead of
+ * a syscall (or a std::random_device and mt19937 construction). Threads
+ * never share a buffer, so concurrent logins do not contend.
+ */
+class TokenGenerator {
+public:
+    /**
+     * @brief Fresh random non-empty token
+     *
+     * @throws std::runtime_error if the kernel CSPRNG is unavailable
+     */
+    static SessionToken next();
+};
+
+} // namespace sql_practice
+
+#endif // TOKEN_GENERATOR_HPP
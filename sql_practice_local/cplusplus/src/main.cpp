@@ -6,12 +6,15 @@
 #include "include/sql_executor.hpp"
 #include "include/question_loader.hpp"
 #include "include/http_server.hpp"
+#include "include/config.hpp"
+#include "include/fixture_catalog.hpp"
+#include "include/solution_runner.hpp"
+#include "include/engine_grader.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <csignal>
 #include <memory>
-#include <thread>
-#include <chrono>
 
 using namespace sql_practice;
 
@@ -19,33 +22,13 @@ using namespace sql_practice;
 std::shared_ptr<HTTPServer> server;
 std::shared_ptr<SessionManager> session_manager;
 std::shared_ptr<QuestionLoader> question_loader;
-std::atomic<bool> running(true);
-
-/**
- * @brief Cleanup session worker thread
- *
- * Runs every 30 seconds to remove expired sessions
- */
-void cleanup_worker() {
-    while (running.load()) {
-        std::this_thread::sleep_for(std::chrono::seconds(30));
-
-        size_t cleaned = session_manager->cleanup_expired();
-        size_t active = session_manager->get_active_count();
-
-        if (cleaned > 0) {
-            std::cout << "🧹 Cleaned up " << cleaned << " expired sessions"
-                      << " | Active: " << active << std::endl;
-        }
-    }
-}
+std::shared_ptr<FixtureCatalog> fixture_catalog;
 
 /**
  * @brief Signal handler for graceful shutdown
  */
 void signal_handler(int signal) {
     std::cout << "\n🛑 Received signal " << signal << ", shutting down..." << std::endl;
-    running.store(false);
 
     if (server) {
         server->stop();
@@ -72,10 +55,38 @@ void print_config() {
     std::cout << "   - Session timeout: 2 minutes" << std::endl;
     std::cout << "   - Database engine: DuckDB (SQL:2003 compliant)" << std::endl;
     std::cout << "   - Embedded questions: " << question_loader->get_count() << std::endl;
+    std::cout << "   - DuckDB instances: " << session_manager->get_instance_pool()->get_instance_count()
+              << " (" << Config::connections_per_instance << " connections each)" << std::endl;
+    std::cout << "   - DuckDB limits for the whole server (split across instances): memory "
+              << (Config::duckdb_memory_limit.empty() ? "default" : Config::duckdb_memory_limit)
+              << ", threads "
+              << (Config::duckdb_threads > 0 ? std::to_string(Config::duckdb_threads) : "one per hardware thread")
+              << ", temp "
+              << (Config::duckdb_max_temp_directory_size.empty() ? "default" : Config::duckdb_max_temp_directory_size)
+              << " under " << (Config::duckdb_temp_directory.empty() ? ".tmp" : Config::duckdb_temp_directory)
+              << std::endl;
     std::cout << "   - Max concurrent users: 10,000+" << std::endl;
     std::cout << std::endl;
 }
 
+/**
+ * @brief Print the slowest reference solutions from the startup check
+ */
+void print_slowest_solutions(const SolutionReport& report, size_t count = 5) {
+    std::vector<const SolutionRun*> runs;
+    for (const auto& run : report.runs) {
+        if (!run.skipped) runs.push_back(&run);
+    }
+    count = std::min(count, runs.size());
+    std::partial_sort(runs.begin(), runs.begin() + count, runs.end(),
+                      [](const SolutionRun* a, const SolutionRun* b) { return a->elapsed_us > b->elapsed_us; });
+
+    for (size_t i = 0; i < count; ++i) {
+        std::cout << "      " << runs[i]->question_id << ": " << runs[i]->elapsed_us << " us, "
+                  << runs[i]->row_count << " rows" << std::endl;
+    }
+}
+
 /**
  * @brief Main entry point
  */
@@ -102,21 +113,54 @@ int main(int argc, char** argv) {
         // Initialize components
         std::cout << "🔧 Initializing components..." << std::endl;
 
+        // 0. Load configuration from environment
+        Config::load_config();
+
         // 1. Load embedded questions
         question_loader = std::make_shared<QuestionLoader>();
         question_loader->load_embedded_questions();
         std::cout << "   ✅ Questions loaded: " << question_loader->get_count() << std::endl;
 
-        // 2. Create session manager (2-min timeout)
+        // 2. Build shared read-only fixture tables once for all sessions
+        fixture_catalog = std::make_shared<FixtureCatalog>(Config::fixture_db_path);
+        size_t fixtures_built = fixture_catalog->build(*question_loader);
+        std::cout << "   ✅ Fixtures built: " << fixtures_built << " ("
+                  << fixture_catalog->get_path() << ")" << std::endl;
+
+        // 2b. Derive expected outputs from the reference solutions (fails fast on a mismatch)
+        auto solutions = derive_expected_outputs(*question_loader, *fixture_catalog,
+                                                 static_cast<size_t>(std::max(Config::query_workers, 0)));
+        std::cout << "   ✅ Solutions verified: " << solutions.derived << " in "
+                  << solutions.elapsed_ms << " ms (" << solutions.worker_count << " workers)" << std::endl;
+        print_slowest_solutions(solutions);
+        for (const auto* run : solutions.over_response_caps()) {
+            std::cout << "   ⚠️  " << run->question_id << ": expected output (" << run->row_count
+                      << " rows) exceeds the response caps; answers are shown truncated but graded on every row"
+                      << std::endl;
+        }
+
+        // 3. Create session manager (2-min timeout, expired by its own timer wheel)
         session_manager = std::make_shared<SessionManager>(120);  // 120 seconds
+        session_manager->get_instance_pool()->set_fixture_catalog(fixture_catalog->get_path(),
+                                                                 fixture_catalog->get_version());
         std::cout << "   ✅ Session manager initialized" << std::endl;
 
-        // 3. Initialize handlers with dependencies
+        // 3b. Load expected outputs on the grading-only DuckDB instance
+        std::shared_ptr<EngineGrader> engine_grader;
+        if (Config::engine_grade_min_rows > 0) {
+            engine_grader = std::make_shared<EngineGrader>(
+                *fixture_catalog, *question_loader,
+                session_manager->get_instance_pool()->get_budget_shares());
+            std::cout << "   ✅ In-engine grading: " << engine_grader->get_question_count()
+                      << " questions (from " << Config::engine_grade_min_rows << " expected rows)" << std::endl;
+        }
+
+        // 4. Initialize handlers with dependencies
         Handlers::init(session_manager, question_loader);
         std::cout << "   ✅ HTTP handlers initialized" << std::endl;
 
-        // 4. Create and start HTTP server
-        server = std::make_shared<HTTPServer>(session_manager, question_loader);
+        // 5. Create and start HTTP server
+        server = std::make_shared<HTTPServer>(session_manager, question_loader, engine_grader);
         std::cout << "   ✅ HTTP server initialized" << std::endl;
 
         print_config();
@@ -125,10 +169,6 @@ int main(int argc, char** argv) {
         std::signal(SIGINT, signal_handler);
         std::signal(SIGTERM, signal_handler);
 
-        // Start cleanup worker thread
-        std::thread cleanup_thread(cleanup_worker);
-        cleanup_thread.detach();
-
         // Start server (blocking)
         std::cout << "🚀 Server starting on port " << port << "..." << std::endl;
         std::cout << "   Health check: http://localhost:" << port << "/health" << std::endl;
@@ -138,7 +178,6 @@ int main(int argc, char** argv) {
 
         // Cleanup on shutdown
         std::cout << "🧹 Cleaning up..." << std::endl;
-        running.store(false);
 
     } catch (const std::exception& e) {
         std::cerr << "❌ Fatal error: " << e.what() << std::endl;
@@ -0,0 +1,101 @@
+/**
+ * In-engine grading with EXCEPT ALL
+ *
+ * Every single-SELECT reference solution must grade as correct inside
+ * DuckDB, both against the hand-written expected rows (whose cells may be
+ * typed differently from DuckDB's output) and against the derived ones,
+ * while a result missing or repeating rows must not. The expected-output
+ * catalog must not be reachable from a session's instance.
+ */
+
+#include "test_support.hpp"
+#include "include/engine_grader.hpp"
+#include "include/fixture_catalog.hpp"
+#include "include/instance_pool.hpp"
+#include "include/question_loader.hpp"
+#include "include/solution_runner.hpp"
+#include <memory>
+#include <string>
+
+using namespace sql_practice;
+
+namespace {
+
+/**
+ * @brief Grade each solution as is and altered; returns how many were graded
+ */
+size_t check_solutions(EngineGrader& grader, const QuestionLoader& loader, DuckDBConnection& session) {
+    size_t graded = 0;
+    for (const auto& entry : loader.get_all_questions()) {
+        const Question& question = *entry;
+        if (!grader.covers(question.id) || question.solution.empty()) continue;
+
+        std::string select_sql = session.parse(question.solution).select_sql();
+        if (select_sql.empty()) continue;
+
+        auto right = grader.grade(select_sql, question, 0);
+        if (!right.success || !right.is_correct) {
+            std::fprintf(stderr, "[%s] solution rejected: %s\n", question.id.c_str(), right.error_message.c_str());
+        }
+        CHECK(right.success);
+        CHECK(right.is_correct);
+
+        // Every row twice: same values, wrong multiplicities
+        auto doubled = grader.grade("SELECT * FROM (\n" + select_sql + "\n) UNION ALL SELECT * FROM (\n" +
+                                    select_sql + "\n)", question, 0);
+        CHECK(doubled.success);
+        CHECK(!doubled.is_correct || question.expected_output.row_count == 0);
+
+        if (question.expected_output.row_count > 0) {
+            auto missing = grader.grade("SELECT * FROM (\n" + select_sql + "\n) LIMIT " +
+                                        std::to_string(question.expected_output.row_count - 1), question, 0);
+            CHECK(missing.success);
+            CHECK(!missing.is_correct);
+        }
+        graded++;
+    }
+    return graded;
+}
+
+} // namespace
+
+int main() {
+    QuestionLoader loader;
+    loader.load_embedded_questions();
+
+    FixtureCatalog catalog;
+    CHECK(catalog.build(loader) > 0);
+
+    auto pool = std::make_shared<DuckDBInstancePool>(1, 10);
+    pool->set_fixture_catalog(catalog.get_path(), catalog.get_version());
+    SQLExecutor executor(pool);
+    auto session = executor.create_connection();
+
+    // Hand-written expected rows
+    {
+        EngineGrader grader(catalog, loader, 1);
+        CHECK(grader.get_question_count() > 0);
+        CHECK(check_solutions(grader, loader, *session) > 0);
+    }
+
+    // Rows derived from the solutions themselves
+    derive_expected_outputs(loader, catalog, 2);
+    EngineGrader grader(catalog, loader, 1);
+    CHECK(check_solutions(grader, loader, *session) > 0);
+
+    // Questions without an expected table are left to the C++ grader
+    Question unknown;
+    unknown.id = "no_such_question";
+    CHECK(!grader.grade("SELECT 1", unknown, 0).success);
+
+    // The expected outputs live on the grading instance only
+    for (const auto& question : loader.get_all_questions()) {
+        if (!grader.covers(question->id)) continue;
+        auto leak = session->execute(std::string("SELECT * FROM ") + EngineGrader::EXPECTED_CATALOG + ".\"" +
+                                     question->id + "\"." + EngineGrader::EXPECTED_TABLE);
+        CHECK(!leak.success);
+        break;
+    }
+
+    return test_exit_code();
+}
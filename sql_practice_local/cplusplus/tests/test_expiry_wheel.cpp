@@ -0,0 +1,148 @@
+/**
+ * ExpiryWheel cascading across levels
+ *
+ * A deadline scheduled into a higher level is moved down each time the
+ * clock crosses that level's boundary. It must fire exactly once, on the
+ * tick it was due, whether it sits just before or just after a level
+ * boundary, was scheduled from a clock part-way through a level, or had
+ * to be clamped into the wheel's range.
+ */
+
+#include "test_support.hpp"
+#include "include/expiry_wheel.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <vector>
+
+using namespace sql_practice;
+
+namespace {
+
+constexpr uint64_t LEVEL1 = uint64_t(1) << ExpiryWheel::LEVEL_BITS;
+constexpr uint64_t LEVEL2 = LEVEL1 << ExpiryWheel::LEVEL_BITS;
+constexpr uint64_t LEVEL3 = LEVEL2 << ExpiryWheel::LEVEL_BITS;
+constexpr uint64_t SPAN = LEVEL3 << ExpiryWheel::LEVEL_BITS;
+
+/**
+ * @brief Ticks at which each token fired; a token firing twice is recorded twice
+ */
+using Fired = std::multimap<uint64_t, uint64_t>;
+
+/**
+ * @brief Advance to end_tick in steps of stride, recording token.lo -> firing tick
+ */
+void run_until(ExpiryWheel& wheel, uint64_t end_tick, uint64_t stride, Fired& fired) {
+    while (wheel.current_tick() < end_tick) {
+        uint64_t next = std::min(end_tick, wheel.current_tick() + stride);
+        wheel.advance(next, [&](const SessionToken& token) { fired.emplace(token.lo, wheel.current_tick()); });
+    }
+}
+
+/**
+ * @brief Schedule each deadline from start_tick and check it fires exactly on time
+ */
+void check_deadlines(uint64_t start_tick, const std::vector<uint64_t>& deadlines, uint64_t stride) {
+    ExpiryWheel wheel(start_tick);
+    uint64_t last = start_tick;
+    for (uint64_t deadline : deadlines) {
+        wheel.schedule(SessionToken{1, deadline}, deadline);
+        last = std::max(last, deadline);
+    }
+    CHECK_EQ(wheel.size(), deadlines.size());
+
+    Fired fired;
+    run_until(wheel, last + 2 * LEVEL1, stride, fired);
+
+    CHECK_EQ(fired.size(), deadlines.size());
+    CHECK_EQ(wheel.size(), size_t(0));
+    for (uint64_t deadline : deadlines) {
+        auto range = fired.equal_range(deadline);
+        bool on_time = std::distance(range.first, range.second) == 1 && range.first->second == deadline;
+        if (!on_time) {
+            std::fprintf(stderr, "start %llu: deadline %llu fired %zu time(s)\n",
+                         static_cast<unsigned long long>(start_tick), static_cast<unsigned long long>(deadline),
+                         static_cast<size_t>(std::distance(range.first, range.second)));
+        }
+        CHECK(on_time);
+    }
+}
+
+void check_level_boundaries() {
+    // Both sides of every level boundary, from the start of the wheel
+    const std::vector<uint64_t> from_zero = {
+        1, 5, LEVEL1 - 1, LEVEL1, LEVEL1 + 1, 2 * LEVEL1 - 1, 2 * LEVEL1,
+        LEVEL2 - 1, LEVEL2, LEVEL2 + 1, LEVEL2 + LEVEL1,
+        LEVEL3 - 1, LEVEL3, LEVEL3 + 1, 300000, 5 * LEVEL3 + 3 * LEVEL2 + 7 * LEVEL1 + 11,
+        SPAN - 1,
+    };
+    check_deadlines(0, from_zero, 1);
+    check_deadlines(0, from_zero, 997);
+
+    // From a clock part-way through levels 1 and 2
+    const std::vector<uint64_t> from_mid = {
+        4091, LEVEL2 - 1, LEVEL2, LEVEL2 + 4, 2 * LEVEL2 - 1, 2 * LEVEL2,
+        LEVEL3 - 1, LEVEL3, LEVEL3 + LEVEL2 + 5, 266000,
+    };
+    check_deadlines(LEVEL2 - 6, from_mid, 1);
+    check_deadlines(LEVEL2 - 6, from_mid, 4093);
+
+    // A clock whose level-3 digit is already non-zero
+    uint64_t late = 7 * LEVEL3 + 63 * LEVEL2 + 63 * LEVEL1 + 60;
+    check_deadlines(late, {late + 3, late + 4, late + 5, late + LEVEL1, late + LEVEL2, late + LEVEL3,
+                           late + SPAN - 1}, 65537);
+}
+
+void check_rescheduling() {
+    // Entries scheduled while the clock runs land in the right level for it
+    ExpiryWheel wheel;
+    Fired fired;
+    run_until(wheel, 100, 1, fired);
+    wheel.schedule(SessionToken{1, 200}, 200);
+    wheel.schedule(SessionToken{1, LEVEL2 + 10}, LEVEL2 + 10);
+
+    run_until(wheel, 4000, 7, fired);
+    wheel.schedule(SessionToken{1, 4100}, 4100);
+    wheel.schedule(SessionToken{1, LEVEL2 + 9}, LEVEL2 + 9);
+
+    run_until(wheel, LEVEL2 + 100, 13, fired);
+    CHECK_EQ(fired.size(), size_t(4));
+    for (const auto& entry : fired) CHECK_EQ(entry.second, entry.first);
+}
+
+void check_clamping() {
+    // A deadline already past fires on the next tick
+    ExpiryWheel wheel(1000);
+    wheel.schedule(SessionToken{1, 1}, 50);
+    wheel.schedule(SessionToken{1, 2}, 1000);
+
+    // A deadline beyond the top level is clamped to its last tick
+    wheel.schedule(SessionToken{1, 3}, 1000 + SPAN * 4);
+
+    Fired fired;
+    run_until(wheel, 1001, 1, fired);
+    CHECK_EQ(fired.size(), size_t(2));
+    CHECK_EQ(fired.count(1), size_t(1));
+    CHECK_EQ(fired.count(2), size_t(1));
+    CHECK_EQ(wheel.size(), size_t(1));
+
+    run_until(wheel, 1000 + SPAN - 2, 1 << 16, fired);
+    CHECK_EQ(fired.count(3), size_t(0));
+    run_until(wheel, 1000 + SPAN - 1, 1, fired);
+    CHECK_EQ(fired.count(3), size_t(1));
+    CHECK_EQ(wheel.size(), size_t(0));
+
+    // Advancing backwards or to the current tick does nothing
+    wheel.advance(5, [&](const SessionToken&) { CHECK(false); });
+    CHECK_EQ(wheel.current_tick(), 1000 + SPAN - 1);
+}
+
+} // namespace
+
+int main() {
+    check_level_boundaries();
+    check_rescheduling();
+    check_clamping();
+    return test_exit_code();
+}
@@ -0,0 +1,186 @@
+/**
+ * Result grading and cell equality
+ *
+ * grade_result must compare unordered results as multisets, so a row
+ * appearing twice on one side and once on the other fails, and ordered
+ * results row by row. CanonicalCell decides what "equal" means for each
+ * cell: one NaN, -0.0 = 0, integral doubles as integers and numeric text
+ * as the number it spells, with both hashes agreeing with operator==.
+ */
+
+#include "test_support.hpp"
+#include "include/canonical_cell.hpp"
+#include "include/result_grader.hpp"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace sql_practice;
+
+namespace {
+
+/**
+ * @brief Two-column (id INTEGER, name TEXT) result with the given rows
+ */
+QueryResult make_result(const std::vector<std::pair<int64_t, std::string>>& rows) {
+    QueryResult result;
+    result.success = true;
+    result.columns = {"id", "name"};
+    result.data.emplace_back(ColumnKind::INTEGER);
+    result.data.emplace_back(ColumnKind::TEXT);
+    for (const auto& row : rows) {
+        result.data[0].append_int(row.first);
+        result.data[1].append_text(row.second);
+    }
+    result.row_count = static_cast<int>(rows.size());
+    return result;
+}
+
+bool same_cell(const CanonicalCell& a, const CanonicalCell& b) {
+    return a == b && a.hash() == b.hash() && a.alt_hash() == b.alt_hash();
+}
+
+CanonicalCell text_cell(const std::string& text) {
+    return CanonicalCell::from_text(text.data(), text.size());
+}
+
+double nan_with_payload(uint64_t payload) {
+    uint64_t bits = 0x7ff8000000000000ULL | payload;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void check_unordered() {
+    auto expected = make_result({{1, "a"}, {2, "b"}, {2, "b"}, {3, "c"}});
+
+    CHECK(grade_result(make_result({{1, "a"}, {2, "b"}, {2, "b"}, {3, "c"}}), expected, GradeMode::UNORDERED));
+    CHECK(grade_result(make_result({{2, "b"}, {3, "c"}, {1, "a"}, {2, "b"}}), expected, GradeMode::UNORDERED));
+
+    // Same values and row count, different multiplicities
+    CHECK(!grade_result(make_result({{1, "a"}, {2, "b"}, {3, "c"}, {3, "c"}}), expected, GradeMode::UNORDERED));
+    CHECK(!grade_result(make_result({{1, "a"}, {1, "a"}, {2, "b"}, {3, "c"}}), expected, GradeMode::UNORDERED));
+
+    // Missing or extra rows
+    CHECK(!grade_result(make_result({{1, "a"}, {2, "b"}, {3, "c"}}), expected, GradeMode::UNORDERED));
+    CHECK(!grade_result(make_result({{1, "a"}, {2, "b"}, {2, "b"}, {2, "b"}, {3, "c"}}), expected,
+                        GradeMode::UNORDERED));
+
+    // A value in a different column of the same row
+    CHECK(!grade_result(make_result({{1, "a"}, {2, "b"}, {2, "c"}, {3, "b"}}), expected, GradeMode::UNORDERED));
+
+    // Both empty
+    CHECK(grade_result(make_result({}), make_result({}), GradeMode::UNORDERED));
+}
+
+void check_ordered() {
+    auto expected = make_result({{1, "a"}, {2, "b"}, {2, "b"}, {3, "c"}});
+
+    CHECK(grade_result(make_result({{1, "a"}, {2, "b"}, {2, "b"}, {3, "c"}}), expected, GradeMode::ORDERED));
+    CHECK(!grade_result(make_result({{2, "b"}, {1, "a"}, {2, "b"}, {3, "c"}}), expected, GradeMode::ORDERED));
+    CHECK(!grade_result(make_result({{1, "a"}, {2, "b"}, {3, "c"}, {3, "c"}}), expected, GradeMode::ORDERED));
+
+    CHECK(grade_mode_from("ordered") == GradeMode::ORDERED);
+    CHECK(grade_mode_from("unordered") == GradeMode::UNORDERED);
+    CHECK(grade_mode_from("") == GradeMode::UNORDERED);
+}
+
+void check_shape() {
+    auto expected = make_result({{1, "a"}, {2, "b"}});
+
+    // Column names must match
+    auto renamed = make_result({{1, "a"}, {2, "b"}});
+    renamed.columns[1] = "full_name";
+    CHECK(!grade_result(renamed, expected, GradeMode::UNORDERED));
+    CHECK(!grade_result(renamed, expected, GradeMode::ORDERED));
+
+    // A truncated result never matches, even when its rows do
+    auto truncated = make_result({{1, "a"}, {2, "b"}});
+    truncated.truncated = true;
+    CHECK(!grade_result(truncated, expected, GradeMode::UNORDERED));
+    CHECK(!grade_result(truncated, expected, GradeMode::ORDERED));
+
+    // Cells of different kinds compare by their canonical value
+    QueryResult doubles;
+    doubles.success = true;
+    doubles.columns = {"id", "name"};
+    doubles.data.emplace_back(ColumnKind::DOUBLE);
+    doubles.data.emplace_back(ColumnKind::TEXT);
+    doubles.data[0].append_double(2.0);
+    doubles.data[0].append_double(1.0);
+    doubles.data[1].append_text("b");
+    doubles.data[1].append_text("a");
+    doubles.row_count = 2;
+    CHECK(grade_result(doubles, expected, GradeMode::UNORDERED));
+    CHECK(!grade_result(doubles, expected, GradeMode::ORDERED));
+
+    // NULL matches only NULL
+    QueryResult with_null = make_result({{1, "a"}});
+    with_null.data[1].append_null();
+    with_null.data[0].append_int(2);
+    with_null.row_count = 2;
+    CHECK(!grade_result(with_null, expected, GradeMode::UNORDERED));
+    CHECK(grade_result(with_null, with_null, GradeMode::UNORDERED));
+}
+
+void check_canonical_cells() {
+    // Every NaN is one value
+    CanonicalCell nan = CanonicalCell::from_double(std::numeric_limits<double>::quiet_NaN());
+    CHECK(same_cell(nan, CanonicalCell::from_double(nan_with_payload(1))));
+    CHECK(same_cell(nan, CanonicalCell::from_double(-std::numeric_limits<double>::quiet_NaN())));
+    CHECK(same_cell(nan, text_cell("nan")));
+    CHECK(nan != CanonicalCell::from_double(1.5));
+
+    // -0.0 and 0 are one value
+    CHECK(same_cell(CanonicalCell::from_double(-0.0), CanonicalCell::from_int(0)));
+    CHECK(same_cell(CanonicalCell::from_double(-0.0), CanonicalCell::from_double(0.0)));
+    CHECK(same_cell(text_cell("-0.0"), CanonicalCell::from_int(0)));
+
+    // Integral doubles are integers
+    CHECK(same_cell(CanonicalCell::from_double(90000.0), CanonicalCell::from_int(90000)));
+    CHECK(same_cell(CanonicalCell::from_double(-42.0), CanonicalCell::from_int(-42)));
+    CHECK(CanonicalCell::from_double(90000.5) != CanonicalCell::from_int(90000));
+    CHECK(CanonicalCell::from_double(1e300).kind == CanonicalCell::Kind::DOUBLE);
+    CHECK(CanonicalCell::from_double(std::numeric_limits<double>::infinity()).kind == CanonicalCell::Kind::DOUBLE);
+    CHECK(CanonicalCell::from_double(-9223372036854775808.0) == CanonicalCell::from_int(INT64_MIN));
+    CHECK(CanonicalCell::from_double(9223372036854775808.0).kind == CanonicalCell::Kind::DOUBLE);
+    CHECK(same_cell(CanonicalCell::from_unsigned(7), CanonicalCell::from_int(7)));
+    CHECK(same_cell(CanonicalCell::from_unsigned(UINT64_MAX), CanonicalCell::from_double(18446744073709551615.0)));
+
+    // Numeric text takes the number's form
+    CHECK(same_cell(text_cell("90000"), CanonicalCell::from_int(90000)));
+    CHECK(same_cell(text_cell("90000.00"), CanonicalCell::from_int(90000)));
+    CHECK(same_cell(text_cell("1.5"), CanonicalCell::from_double(1.5)));
+    CHECK(same_cell(text_cell("-3"), CanonicalCell::from_double(-3.0)));
+    CHECK(same_cell(text_cell("1e3"), CanonicalCell::from_int(1000)));
+
+    // Anything else compares by its bytes
+    CHECK(text_cell("90000 ").kind == CanonicalCell::Kind::TEXT);
+    CHECK(text_cell("+5").kind == CanonicalCell::Kind::TEXT);
+    CHECK(text_cell("").kind == CanonicalCell::Kind::TEXT);
+    CHECK(same_cell(text_cell("Alice"), text_cell("Alice")));
+    CHECK(text_cell("Alice") != text_cell("alice"));
+    CHECK(text_cell("") != CanonicalCell::null());
+
+    // Booleans are their text
+    CHECK(same_cell(CanonicalCell::from_bool(true), text_cell("true")));
+    CHECK(same_cell(CanonicalCell::from_bool(false), text_cell("false")));
+    CHECK(CanonicalCell::from_bool(true) != CanonicalCell::from_int(1));
+
+    // NULL equals only NULL
+    CHECK(same_cell(CanonicalCell::null(), CanonicalCell::null()));
+    CHECK(CanonicalCell::null() != CanonicalCell::from_int(0));
+    CHECK(CanonicalCell::null() != text_cell("NULL"));
+}
+
+} // namespace
+
+int main() {
+    check_unordered();
+    check_ordered();
+    check_shape();
+    check_canonical_cells();
+    return test_exit_code();
+}
@@ -0,0 +1,148 @@
+/**
+ * SessionIndex probing after erase
+ *
+ * erase() closes the hole by shifting later entries of the probe run back
+ * instead of leaving a tombstone. Every entry left in the table must stay
+ * reachable from its home slot afterwards, including runs that wrap past
+ * the end of the slot array and entries displaced from a neighbouring
+ * home, and the table must keep working through growth and churn.
+ */
+
+#include "test_support.hpp"
+#include "include/session_index.hpp"
+#include "include/session_manager.hpp"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace sql_practice;
+
+namespace {
+
+// hi = 0 makes the home slot lo & mask, so tests can pick collisions
+SessionToken token_at(uint64_t lo) {
+    return SessionToken{0, lo};
+}
+
+std::shared_ptr<UserSession> make_session(const SessionToken& token) {
+    return std::make_shared<UserSession>("user", token);
+}
+
+/**
+ * @brief True if exactly the expected tokens are found, each to its own session
+ */
+bool matches(const SessionIndex& index, const std::map<uint64_t, std::shared_ptr<UserSession>>& expected) {
+    if (index.size() != expected.size()) return false;
+    for (const auto& entry : expected) {
+        if (index.find(token_at(entry.first)) != entry.second) return false;
+    }
+    size_t visited = 0;
+    index.for_each([&](const SessionToken&, const std::shared_ptr<UserSession>&) { visited++; });
+    return visited == expected.size();
+}
+
+/**
+ * @brief Insert tokens into a 16-slot table, erase them in order, check after each step
+ */
+void check_erase_order(const std::vector<uint64_t>& tokens, const std::vector<uint64_t>& erase_order) {
+    SessionIndex index(16);
+    std::map<uint64_t, std::shared_ptr<UserSession>> expected;
+    for (uint64_t lo : tokens) {
+        auto session = make_session(token_at(lo));
+        index.insert(token_at(lo), session);
+        expected[lo] = session;
+    }
+    CHECK_EQ(index.capacity(), size_t(16));
+    CHECK(matches(index, expected));
+
+    for (uint64_t lo : erase_order) {
+        auto removed = index.erase(token_at(lo));
+        CHECK(removed == expected[lo]);
+        expected.erase(lo);
+        CHECK(index.find(token_at(lo)) == nullptr);
+        CHECK(matches(index, expected));
+    }
+    CHECK_EQ(index.size(), size_t(0));
+}
+
+void check_probe_runs() {
+    // Homes 14, 14, 14, 15, 0, 1: one run over slots 14..3, wrapping at 16
+    const std::vector<uint64_t> wrapping = {14, 30, 46, 15, 16, 1};
+    std::vector<uint64_t> order = wrapping;
+    std::sort(order.begin(), order.end());
+    do {
+        check_erase_order(wrapping, order);
+    } while (std::next_permutation(order.begin(), order.end()));
+
+    // Homes 3, 3, 4, 3, 6: entries displaced from home 3 past home 4's entry
+    check_erase_order({3, 19, 4, 35, 6}, {3, 4, 19, 35, 6});
+    check_erase_order({3, 19, 4, 35, 6}, {19, 6, 35, 3, 4});
+    check_erase_order({3, 19, 4, 35, 6}, {4, 35, 3, 6, 19});
+}
+
+void check_edges() {
+    SessionIndex index(16);
+    auto first = make_session(token_at(5));
+    index.insert(token_at(5), first);
+
+    // Absent keys, including one probing through an occupied home
+    CHECK(index.erase(token_at(21)) == nullptr);
+    CHECK(index.erase(token_at(6)) == nullptr);
+    CHECK(index.erase(SessionToken{}) == nullptr);
+    CHECK(index.find(SessionToken{}) == nullptr);
+    CHECK_EQ(index.size(), size_t(1));
+
+    // The empty token is never stored
+    index.insert(SessionToken{}, make_session(SessionToken{}));
+    CHECK_EQ(index.size(), size_t(1));
+
+    // Insert replaces an existing key
+    auto second = make_session(token_at(5));
+    index.insert(token_at(5), second);
+    CHECK_EQ(index.size(), size_t(1));
+    CHECK(index.find(token_at(5)) == second);
+
+    // Reinsert after erase
+    CHECK(index.erase(token_at(5)) == second);
+    index.insert(token_at(5), first);
+    CHECK(index.find(token_at(5)) == first);
+
+    // Capacity rounds up to a power of two, at least 8
+    CHECK_EQ(SessionIndex(0).capacity(), size_t(8));
+    CHECK_EQ(SessionIndex(100).capacity(), size_t(128));
+}
+
+void check_growth_and_churn() {
+    SessionIndex index(8);
+    std::map<uint64_t, std::shared_ptr<UserSession>> expected;
+    std::mt19937_64 rng(42);
+
+    // Few distinct homes, so probe runs are long and overlap
+    for (int step = 0; step < 20000; ++step) {
+        uint64_t lo = (rng() % 64) * 8 + 1 + rng() % 3;
+        if (rng() % 3 == 0 || expected.count(lo)) {
+            auto removed = index.erase(token_at(lo));
+            auto it = expected.find(lo);
+            CHECK(removed == (it == expected.end() ? nullptr : it->second));
+            if (it != expected.end()) expected.erase(it);
+        } else {
+            auto session = make_session(token_at(lo));
+            index.insert(token_at(lo), session);
+            expected[lo] = session;
+        }
+        CHECK(index.size() * 4 <= index.capacity() * 3);
+    }
+    CHECK(matches(index, expected));
+    CHECK(index.capacity() > 8);
+}
+
+} // namespace
+
+int main() {
+    check_probe_runs();
+    check_edges();
+    check_growth_and_churn();
+    return test_exit_code();
+}
@@ -0,0 +1,133 @@
+/**
+ * Session isolation on a shared DuckDB instance
+ *
+ * Two sessions lease the same pooled instance, so both session catalogs
+ * are attached to one database. The second session must not be able to
+ * read the first one's tables, or even learn their names, through any
+ * query that passes SQLExecutor::validate. Nor may they pass state to each
+ * other through a catalog both can reach, such as DuckDB's default
+ * "memory", which the pool detaches.
+ */
+
+#include "test_support.hpp"
+#include "include/sql_executor.hpp"
+#include "include/instance_pool.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace sql_practice;
+
+namespace {
+
+bool rejected(SQLExecutor& executor, DuckDBConnection* conn, const std::string& sql) {
+    return !executor.validate(conn, sql, {}).is_valid();
+}
+
+/**
+ * @brief Run sql as a student would: validate, then execute what passes
+ */
+QueryResult run_student_query(SQLExecutor& executor, DuckDBConnection* conn, const std::string& sql) {
+    auto parsed = executor.validate(conn, sql, {});
+    if (!parsed.is_valid()) {
+        QueryResult result;
+        result.error_message = parsed.error_message;
+        return result;
+    }
+    return executor.execute(conn, std::move(parsed), ResultLimits(), nullptr, true);
+}
+
+bool contains(const QueryResult& result, const std::string& text) {
+    for (const auto& column : result.data) {
+        for (size_t row = 0; row < column.size(); ++row) {
+            if (column.to_string(row).find(text) != std::string::npos) return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int main() {
+    auto pool = std::make_shared<DuckDBInstancePool>(1, 10);
+    SQLExecutor executor(pool);
+
+    auto owner = executor.create_connection();
+    auto other = executor.create_connection();
+    CHECK(owner->get_connection() != nullptr);
+    CHECK(other->get_connection() != nullptr);
+    CHECK_EQ(owner->get_instance_id(), other->get_instance_id());
+    CHECK(owner->get_catalog_name() != other->get_catalog_name());
+
+    CHECK(owner->execute("CREATE TABLE secret_answers (answer VARCHAR)").success);
+    CHECK(owner->execute("INSERT INTO secret_answers VALUES ('forty-two')").success);
+    CHECK(contains(owner->execute("SELECT answer FROM secret_answers"), "forty-two"));
+
+    const std::string& owner_catalog = owner->get_catalog_name();
+
+    // Naming the other catalog, directly or as a string argument
+    CHECK(rejected(executor, other.get(), "SELECT * FROM " + owner_catalog + ".secret_answers"));
+    CHECK(rejected(executor, other.get(), "SELECT * FROM \"" + owner_catalog + "\".main.secret_answers"));
+    CHECK(rejected(executor, other.get(), "SELECT * FROM pragma_table_info('" + owner_catalog + ".secret_answers')"));
+
+    // Metadata that spans every attached database
+    const std::vector<std::string> metadata_queries = {
+        "SELECT table_name FROM duckdb_tables()",
+        "SELECT database_name FROM duckdb_databases()",
+        "SELECT * FROM duckdb_columns() WHERE column_name = 'answer'",
+        "SELECT schema_name FROM DuckDB_Schemas()",
+        "SELECT table_catalog, table_name FROM information_schema.tables",
+        "SELECT * FROM information_schema.columns",
+        "SELECT relname FROM pg_catalog.pg_class",
+        "SELECT tablename FROM pg_tables",
+        "FROM duckdb_tables",
+        "SELECT * FROM pragma_database_list()",
+        "SHOW ALL TABLES",
+        "SHOW DATABASES",
+        "DESCRIBE",
+        "-- list everything\nshow   all tables;",
+    };
+    for (const auto& sql : metadata_queries) {
+        bool is_rejected = rejected(executor, other.get(), sql);
+        if (!is_rejected) std::fprintf(stderr, "accepted: %s\n", sql.c_str());
+        CHECK(is_rejected);
+    }
+
+    // No shared catalog: memory.main is gone, even for SQL that skips validate
+    CHECK(!owner->execute("CREATE TABLE memory.main.shared AS SELECT 'forty-two' AS answer").success);
+    CHECK(!owner->execute("CREATE TABLE memory.shared (answer VARCHAR)").success);
+    CHECK(!other->execute("SELECT * FROM memory.main.shared").success);
+    CHECK(rejected(executor, owner.get(), "SELECT * FROM memory.main.shared"));
+    CHECK(rejected(executor, other.get(), "SELECT * FROM Memory.shared"));
+    CHECK(rejected(executor, other.get(), "SELECT * FROM Employee WHERE id IN (SELECT id FROM memory.main.shared)"));
+    CHECK(rejected(executor, other.get(), "SELECT * FROM system.main.duckdb_tables"));
+
+    // Unqualified names resolve in the session's own catalog only
+    auto direct = run_student_query(executor, other.get(), "SELECT answer FROM secret_answers");
+    CHECK(!direct.success);
+
+    // Ordinary queries on the session's own tables still pass
+    CHECK(other->execute("CREATE TABLE Employee (id INTEGER, name VARCHAR, salary INTEGER)").success);
+    CHECK(other->execute("INSERT INTO Employee VALUES (1, 'Alice', 90000), (2, 'Bob', 80000)").success);
+    auto own = run_student_query(executor, other.get(),
+                                 "SELECT name, salary AS show_all FROM Employee ORDER BY salary DESC");
+    CHECK(own.success);
+    CHECK_EQ(own.row_count, 2);
+    CHECK(!contains(own, "forty-two"));
+
+    // Only table and function references count, not literals, comments or aliases
+    const std::vector<std::string> harmless_queries = {
+        "SELECT 'sess_1' AS \"memory\" -- duckdb_tables()",
+        "SELECT name AS \"information_schema\" FROM Employee /* SHOW DATABASES */",
+        "SELECT name FROM Employee WHERE name <> '" + owner_catalog + ".secret_answers'",
+        "WITH memory AS (SELECT 1 AS x) SELECT x FROM memory",
+        "SELECT name FROM " + other->get_catalog_name() + ".main.Employee",
+    };
+    for (const auto& sql : harmless_queries) {
+        auto result = run_student_query(executor, other.get(), sql);
+        if (!result.success) std::fprintf(stderr, "failed: %s: %s\n", sql.c_str(), result.error_message.c_str());
+        CHECK(result.success);
+    }
+
+    return test_exit_code();
+}
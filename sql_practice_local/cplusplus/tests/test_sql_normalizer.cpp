@@ -0,0 +1,116 @@
+/**
+ * SQL normalization for the result cache
+ *
+ * Spellings of one query that differ only in whitespace, comments, keyword
+ * case or trailing semicolons must share a cache key, while anything that
+ * could change the answer must not. read_only must hold only for a single
+ * statement that cannot write, and deterministic only when no volatile
+ * function or session catalog is named, since the cache relies on both.
+ */
+
+#include "test_support.hpp"
+#include "include/sql_normalizer.hpp"
+#include <string>
+#include <vector>
+
+using namespace sql_practice;
+
+namespace {
+
+void check_text() {
+    auto base = normalize_sql("SELECT name FROM Employee WHERE salary > 100");
+    const std::vector<std::string> same = {
+        "select name from Employee where salary > 100",
+        "  SELECT\n\tname\nFROM   Employee\nWHERE salary>100 ;",
+        "SELECT name -- the name\nFROM Employee /* all of them */ WHERE salary > 100;;",
+    };
+    for (const auto& sql : same) {
+        auto normalized = normalize_sql(sql);
+        CHECK_EQ(normalized.text, base.text);
+        CHECK_EQ(normalized.hash, base.hash);
+    }
+
+    // Identifiers keep their spelling: DuckDB uses it for column names
+    CHECK(normalize_sql("SELECT Name FROM Employee").text != normalize_sql("SELECT name FROM Employee").text);
+
+    // Literals and quoted identifiers are kept verbatim
+    CHECK(normalize_sql("SELECT 'a  b'").text != normalize_sql("SELECT 'a b'").text);
+    CHECK(normalize_sql("SELECT 'select'").text != normalize_sql("SELECT 'SELECT'").text);
+    CHECK(normalize_sql("SELECT '--x' AS v").text.find("--x") != std::string::npos);
+    CHECK(normalize_sql("SELECT \"My Col\" FROM t").text.find("\"My Col\"") != std::string::npos);
+
+    // Different queries, different keys
+    CHECK(normalize_sql("SELECT 1").hash != normalize_sql("SELECT 2").hash);
+    CHECK(normalize_sql("SELECT a-1").text != normalize_sql("SELECT a - -1").text);
+}
+
+void check_read_only() {
+    const std::vector<std::string> reads = {
+        "SELECT 1",
+        "select * from Employee;",
+        "WITH t AS (SELECT 1 AS x) SELECT x FROM t",
+        "VALUES (1), (2)",
+        "FROM Employee",
+        "-- comment first\nSELECT 1",
+        "SELECT 'insert into t values (1)' AS s",
+        "SELECT 1; ; ",
+    };
+    for (const auto& sql : reads) {
+        bool read_only = normalize_sql(sql).read_only;
+        if (!read_only) std::fprintf(stderr, "not read-only: %s\n", sql.c_str());
+        CHECK(read_only);
+    }
+
+    const std::vector<std::string> writes = {
+        "",
+        "INSERT INTO Employee VALUES (1)",
+        "UPDATE Employee SET salary = 0",
+        "DELETE FROM Employee",
+        "CREATE TABLE t AS SELECT 1",
+        "DROP TABLE Employee",
+        "SET threads = 1",
+        "PRAGMA table_info('Employee')",
+        "SELECT 1; SELECT 2",
+        "SELECT 1; DROP TABLE Employee",
+        "WITH t AS (SELECT 1) INSERT INTO Employee SELECT * FROM t",
+        "EXPLAIN SELECT 1",
+        "ATTACH 'x.db'",
+    };
+    for (const auto& sql : writes) {
+        bool read_only = normalize_sql(sql).read_only;
+        if (read_only) std::fprintf(stderr, "read-only: %s\n", sql.c_str());
+        CHECK(!read_only);
+    }
+}
+
+void check_deterministic() {
+    CHECK(normalize_sql("SELECT name FROM Employee ORDER BY salary").deterministic);
+    CHECK(normalize_sql("SELECT 'random()' AS s").deterministic);
+    CHECK(normalize_sql("SELECT randomness FROM t").deterministic);
+
+    const std::vector<std::string> volatile_queries = {
+        "SELECT random()",
+        "SELECT * FROM Employee ORDER BY RANDOM() LIMIT 1",
+        "SELECT now()",
+        "SELECT current_date",
+        "SELECT CURRENT_TIMESTAMP",
+        "SELECT uuid()",
+        "SELECT nextval('seq')",
+        "SELECT * FROM sess_3.main.secret",
+        "SELECT * FROM SESS_12.t",
+    };
+    for (const auto& sql : volatile_queries) {
+        bool deterministic = normalize_sql(sql).deterministic;
+        if (deterministic) std::fprintf(stderr, "deterministic: %s\n", sql.c_str());
+        CHECK(!deterministic);
+    }
+}
+
+} // namespace
+
+int main() {
+    check_text();
+    check_read_only();
+    check_deterministic();
+    return test_exit_code();
+}
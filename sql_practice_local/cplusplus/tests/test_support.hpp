@@ -0,0 +1,41 @@
+#ifndef TEST_SUPPORT_HPP
+#define TEST_SUPPORT_HPP
+
+/**
+ * Minimal assertion helpers shared by the unit tests
+ *
+ * Each test executable runs its cases from main() and returns
+ * test_exit_code(), so ctest reports any failed CHECK.
+ */
+
+#include <cstdio>
+
+namespace test_support {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+} // namespace test_support
+
+#define CHECK(condition)                                                                  \
+    do {                                                                                  \
+        if (!(condition)) {                                                               \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            test_support::failures()++;                                                   \
+        }                                                                                 \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) CHECK((actual) == (expected))
+
+inline int test_exit_code() {
+    if (test_support::failures() == 0) {
+        std::printf("All checks passed\n");
+        return 0;
+    }
+    std::fprintf(stderr, "%d check(s) failed\n", test_support::failures());
+    return 1;
+}
+
+#endif // TEST_SUPPORT_HPP
@@ -250,8 +250,8 @@ function showResults(result, message, type) {
     // Display rows
     if (result.rows && result.rows.length > 0) {
         resultsTbody.innerHTML = result.rows.map(row => {
-            const cells = result.columns.map(col => {
-                const val = row[col] !== undefined ? row[col] : 'NULL';
+            const cells = result.columns.map((col, i) => {
+                const val = row[i] !== undefined && row[i] !== null ? row[i] : 'NULL';
                 return `<td>${val}</td>`;
             }).join('');
             return `<tr>${cells}</tr>`;
@@ -263,7 +263,8 @@ function showResults(result, message, type) {
     // Show stats
     const rowCount = result.rows ? result.rows.length : 0;
     const execTime = result.execution_time_ms || 0;
-    resultsStats.textContent = `${rowCount} row${rowCount !== 1 ? 's' : ''} returned in ${execTime}ms`;
+    const truncatedNote = result.truncated ? ' (truncated - result exceeded the size limit)' : '';
+    resultsStats.textContent = `${rowCount} row${rowCount !== 1 ? 's' : ''} returned in ${execTime}ms${truncatedNote}`;
 }
 
 // Reset editor